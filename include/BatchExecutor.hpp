@@ -0,0 +1,88 @@
+#pragma once
+
+#include "pathfinders/Pathfinder.hpp"
+#include "ThreadPool.hpp"
+#include "Maze.hpp"
+#include <vector>
+#include <memory>
+#include <bits/stdc++.h>
+
+// Answers many start/goal queries against one shared maze on a
+// WorkStealingPool. The maze is only read. Every worker owns a pathfinder
+// built by the factory and keeps it, with its open list and per-cell state,
+// across all the queries and batches it serves. Per-map preprocessing is
+// built once by the first worker's pathfinder and shared with the others.
+class BatchExecutor {
+public:
+    struct Query {
+        Maze::Point start;
+        Maze::Point goal;
+    };
+
+    struct BatchResult {
+        std::vector<Pathfinder::PathfindingResult> results;  // in query order
+        std::vector<double> latencies;  // search time per query, queueing excluded, in milliseconds
+        double totalTime = 0;           // whole batch, in milliseconds
+        double queriesPerSecond = 0;
+
+        // Latency that the given fraction of queries (0.5, 0.99, ...) stayed within
+        double latencyPercentile(double fraction) const {
+            if (latencies.empty()) return 0;
+            std::vector<double> sorted = latencies;
+            size_t rank = static_cast<size_t>(std::ceil(fraction * sorted.size()));
+            rank = std::min(std::max<size_t>(rank, 1), sorted.size()) - 1;
+            std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+            return sorted[rank];
+        }
+    };
+
+    using Factory = std::function<std::unique_ptr<Pathfinder>()>;
+
+    // threads == 0 uses every hardware thread
+    explicit BatchExecutor(const Factory& factory, unsigned threads = 0) : pool_(threads) {
+        for (unsigned worker = 0; worker < pool_.size(); ++worker) {
+            workspaces_.push_back(factory());
+        }
+    }
+
+    unsigned getThreadCount() const { return pool_.size(); }
+
+    // Builds the per-map preprocessing once, on the calling thread, and
+    // hands it to every worker ahead of a batch, so the first queries do
+    // not pay for it
+    void prepare(const Maze& maze) {
+        workspaces_.front()->prepare(maze);
+        for (size_t worker = 1; worker < workspaces_.size(); ++worker) {
+            if (!workspaces_[worker]->sharePreprocessing(*workspaces_.front())) {
+                workspaces_[worker]->prepare(maze);
+            }
+        }
+    }
+
+    BatchResult run(const Maze& maze, const std::vector<Query>& queries) {
+        BatchResult batch;
+        batch.results.resize(queries.size());
+        batch.latencies.resize(queries.size());
+
+        // Shared preprocessing is brought up to date here, before any worker
+        // reads it
+        workspaces_.front()->prepare(maze);
+
+        auto batchStart = std::chrono::high_resolution_clock::now();
+        pool_.run(queries.size(), [&](size_t index, unsigned worker) {
+            auto queryStart = std::chrono::high_resolution_clock::now();
+            batch.results[index] = workspaces_[worker]->findPath(maze, queries[index].start, queries[index].goal);
+            auto queryEnd = std::chrono::high_resolution_clock::now();
+            batch.latencies[index] = std::chrono::duration<double, std::milli>(queryEnd - queryStart).count();
+        });
+        auto batchEnd = std::chrono::high_resolution_clock::now();
+
+        batch.totalTime = std::chrono::duration<double, std::milli>(batchEnd - batchStart).count();
+        batch.queriesPerSecond = batch.totalTime > 0 ? queries.size() * 1000.0 / batch.totalTime : 0;
+        return batch;
+    }
+
+private:
+    WorkStealingPool pool_;
+    std::vector<std::unique_ptr<Pathfinder>> workspaces_;  // one per worker
+};
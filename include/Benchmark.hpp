@@ -16,34 +16,56 @@ public:
         size_t averageNodesExplored;
         size_t averagePathLength;
         size_t averageMemoryUsage;
+        double preprocessingTime;  // one-off prepare() cost, in milliseconds
+        double replanTime;         // answering again after a one-cell edit on the path, in milliseconds
+        size_t replanSkipped;      // replan samples with no edit that kept start and goal connected
+        size_t stoppedQueries;     // timed queries cut short by the query limits
     };
 
     Benchmark(const std::vector<std::unique_ptr<Pathfinder>>& algorithms)
         : algorithms_(algorithms) {}
 
+    // Limits for every query the benchmark runs, so one pathological
+    // algorithm cannot stall the whole run; each algorithm's own limits
+    // are restored afterwards
+    void setQueryLimits(const Pathfinder::SearchLimits& limits) { queryLimits_ = limits; }
+
     std::vector<BenchmarkResult> runBenchmarks(const Maze& maze, int iterations, bool visualize = false) {
         std::vector<BenchmarkResult> results;
         
         for (const auto& algorithm : algorithms_) {
+            LimitScope scope(*algorithm, queryLimits_);
             BenchmarkResult result;
             result.algorithmName = algorithm->getName();
+            result.stoppedQueries = 0;
             result.averageTime = 0;
             result.averageNodesExplored = 0;
             result.averagePathLength = 0;
             result.averageMemoryUsage = 0;
 
+            // Per-map preprocessing is paid once, outside the timed queries
+            auto prepareStart = std::chrono::high_resolution_clock::now();
+            algorithm->prepare(maze);
+            auto prepareEnd = std::chrono::high_resolution_clock::now();
+            result.preprocessingTime = std::chrono::duration<double, std::milli>(prepareEnd - prepareStart).count();
+
             for (int i = 0; i < iterations; ++i) {
                 auto pathResult = algorithm->findPath(maze);
                 result.averageTime += pathResult.executionTime;
                 result.averageNodesExplored += pathResult.nodesExplored;
                 result.averagePathLength += pathResult.pathLength;
                 result.averageMemoryUsage += pathResult.memoryUsage;
+                if (pathResult.status != Pathfinder::SearchStatus::FOUND &&
+                    pathResult.status != Pathfinder::SearchStatus::NO_PATH) {
+                    result.stoppedQueries++;
+                }
             }
 
             result.averageTime /= iterations;
             result.averageNodesExplored /= iterations;
             result.averagePathLength /= iterations;
             result.averageMemoryUsage /= iterations;
+            result.replanTime = measureReplanning(*algorithm, maze, iterations, result.replanSkipped);
 
             results.push_back(result);
         }
@@ -56,7 +78,7 @@ public:
         if (!file.is_open()) return;
 
         // Write header
-        file << "Algorithm,Time (ms),Nodes Explored,Path Length,Memory Usage (bytes)\n";
+        file << "Algorithm,Time (ms),Nodes Explored,Path Length,Memory Usage (bytes),Preprocessing (ms),Replan (ms),Replan Skipped,Stopped\n";
 
         // Write data
         for (const auto& result : results) {
@@ -64,7 +86,11 @@ public:
                  << std::fixed << std::setprecision(2) << result.averageTime << ","
                  << result.averageNodesExplored << ","
                  << result.averagePathLength << ","
-                 << result.averageMemoryUsage << "\n";
+                 << result.averageMemoryUsage << ","
+                 << result.preprocessingTime << ","
+                 << result.replanTime << ","
+                 << result.replanSkipped << ","
+                 << result.stoppedQueries << "\n";
         }
     }
 
@@ -74,8 +100,8 @@ public:
 
         // Write header
         file << "# Pathfinding Algorithm Benchmark Results\n\n";
-        file << "| Algorithm | Time (ms) | Nodes Explored | Path Length | Memory Usage (KB) |\n";
-        file << "|-----------|-----------|----------------|-------------|------------------|\n";
+        file << "| Algorithm | Time (ms) | Nodes Explored | Path Length | Memory Usage (KB) | Preprocessing (ms) | Replan (ms) | Replan Skipped | Stopped |\n";
+        file << "|-----------|-----------|----------------|-------------|------------------|--------------------|-------------|----------------|---------|\n";
 
         // Write data
         for (const auto& result : results) {
@@ -83,7 +109,11 @@ public:
                  << std::fixed << std::setprecision(2) << result.averageTime << " | "
                  << result.averageNodesExplored << " | "
                  << result.averagePathLength << " | "
-                 << (result.averageMemoryUsage / 1024) << " |\n";
+                 << (result.averageMemoryUsage / 1024) << " | "
+                 << result.preprocessingTime << " | "
+                 << result.replanTime << " | "
+                 << result.replanSkipped << " | "
+                 << result.stoppedQueries << " |\n";
         }
 
         // Add timestamp
@@ -92,6 +122,116 @@ public:
         file << "\n\nBenchmark run at: " << std::ctime(&time);
     }
 
+    // Solution quality against elapsed time, one row per path a query
+    // returns on its way to the answer: every improvement of an anytime
+    // search, the single final path of the others
+    void exportAnytimeCSV(const Maze& maze, const std::string& filename) {
+        std::ofstream file(filename);
+        if (!file.is_open()) return;
+
+        file << "Algorithm,Elapsed (ms),Bound,Cost,Path Length\n";
+        for (const auto& algorithm : algorithms_) {
+            LimitScope scope(*algorithm, queryLimits_);
+            algorithm->prepare(maze);  // untimed, as in runBenchmarks
+            auto result = algorithm->findPath(maze);
+            if (result.status != Pathfinder::SearchStatus::FOUND) continue;
+
+            std::vector<Pathfinder::Improvement> improvements = result.improvements;
+            if (improvements.empty()) {
+                Pathfinder::Improvement answer;
+                answer.elapsed = result.executionTime;
+                answer.bound = result.suboptimalityBound;
+                answer.cost = octileLength(result.path);
+                answer.pathLength = result.pathLength;
+                improvements.push_back(answer);
+            }
+            for (const auto& improvement : improvements) {
+                file << algorithm->getName() << ","
+                     << std::fixed << std::setprecision(3) << improvement.elapsed << ","
+                     << improvement.bound << ","
+                     << improvement.cost << ","
+                     << improvement.pathLength << "\n";
+            }
+        }
+    }
+
 private:
     const std::vector<std::unique_ptr<Pathfinder>>& algorithms_;
+    Pathfinder::SearchLimits queryLimits_;
+
+    static constexpr size_t MAX_REPLAN_ATTEMPTS = 64;
+
+    // Swaps the benchmark's query limits in for the lifetime of the scope
+    class LimitScope {
+    public:
+        LimitScope(Pathfinder& algorithm, const Pathfinder::SearchLimits& limits)
+            : algorithm_(algorithm), previous_(algorithm.getLimits()) {
+            algorithm_.setLimits(limits);
+        }
+        ~LimitScope() { algorithm_.setLimits(previous_); }
+
+    private:
+        Pathfinder& algorithm_;
+        Pathfinder::SearchLimits previous_;
+    };
+
+    // Path cost in the units of Pathfinder::Improvement::cost
+    static double octileLength(const std::vector<Maze::Point>& path) {
+        int tenths = 0;
+        for (size_t i = 1; i < path.size(); ++i) {
+            tenths += (path[i].x != path[i - 1].x && path[i].y != path[i - 1].y) ? 14 : 10;
+        }
+        return tenths / 10.0;
+    }
+
+    // Block a cell along the current path, query, clear it and query again,
+    // on a copy of the maze. Planners that keep state between queries only
+    // pay for the repair; the others search from scratch.
+    //
+    // A wall that cuts the start off from the goal would only time the
+    // unreachable-goal check, so such a cell is passed over for the next one
+    // along the path. Samples that find no such cell within
+    // MAX_REPLAN_ATTEMPTS are left out of the average and counted in
+    // `skipped`.
+    double measureReplanning(Pathfinder& algorithm, const Maze& maze, int iterations, size_t& skipped) {
+        Maze edited = maze;
+        std::vector<Maze::Point> path = algorithm.findPath(edited).path;
+
+        double total = 0.0;
+        size_t timed = 0;
+        skipped = 0;
+        if (path.size() >= 3) {
+            const Maze::Point start = path.front();
+            const Maze::Point goal = path.back();
+            const size_t interior = path.size() - 2;
+            for (int i = 0; i < iterations; ++i) {
+                const size_t first = (static_cast<size_t>(i) * 7919) % interior;
+                bool sampled = false;
+                for (size_t attempt = 0; attempt < std::min(interior, MAX_REPLAN_ATTEMPTS) && !sampled; ++attempt) {
+                    const Maze::Point cell = path[1 + (first + attempt) % interior];
+                    edited.setCellType(cell.x, cell.y, Maze::CellType::WALL);
+                    if (edited.areConnected(start, goal)) {
+                        total += algorithm.findPath(edited).executionTime;
+                        edited.setCellType(cell.x, cell.y, Maze::CellType::PATH);
+                        total += algorithm.findPath(edited).executionTime;
+                        timed += 2;
+                        sampled = true;
+                    } else {
+                        edited.setCellType(cell.x, cell.y, Maze::CellType::PATH);
+                    }
+                }
+                if (!sampled) ++skipped;
+            }
+            if (timed > 0) total /= timed;
+        } else {
+            skipped = iterations;
+        }
+
+        // The algorithm's state now follows walkability stamps the maze
+        // itself never had. Rebuild it on the maze, untimed, so the next
+        // query finds the state the timed runs left behind.
+        algorithm.prepare(maze);
+        algorithm.findPath(maze);
+        return total;
+    }
 }; 
\ No newline at end of file
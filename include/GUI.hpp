@@ -2,7 +2,10 @@
 
 #include <SFML/Graphics.hpp>
 #include "Maze.hpp"
+#include "MazeRenderer.hpp"
 #include "pathfinders/Pathfinder.hpp"
+#include "SteppedSearch.hpp"
+#include "TraceReplay.hpp"
 #include <memory>
 #include <vector>
 #include <string>
@@ -23,6 +26,7 @@ private:
     
     // Maze and pathfinding
     Maze maze_;
+    MazeRenderer renderer_;
     std::vector<std::unique_ptr<Pathfinder>> algorithms_;
     size_t currentAlgorithm_;
     Pathfinder::PathfindingResult lastResult_;
@@ -50,10 +54,17 @@ private:
     // UI states
     bool isRunning_;
     bool isDragging_;
+    bool isPanning_;
+    sf::Vector2i panOrigin_;  // window pixel the maze was grabbed at
     Maze::CellType currentDrawMode_;
     bool isVisualizing_;
     std::vector<Maze::Point> currentPath_;
     Maze::Point currentNode_;
+    std::unique_ptr<SteppedSearch> search_;  // the running query, traced off the UI thread
+    SearchTrace trace_;
+    std::unique_ptr<TraceReplay> replay_;    // the last query, played back once per frame
+    size_t stepsPerFrame_;
+    bool replayPaused_;
     
     // Initialize methods
     void initWindow(int width, int height);
@@ -69,6 +80,9 @@ private:
     void handleMouseDrag(const sf::Vector2i& mousePos);
     void handleKeyPress(const sf::Event& event);
     void handleDropdownClick(const sf::Vector2i& mousePos);
+    void zoomView(float factor, const sf::Vector2i& mousePos);
+    void panView(const sf::Vector2i& mousePos);
+    void fitView();
     
     // Drawing methods
     void draw();
@@ -80,6 +94,12 @@ private:
     // Helper methods
     sf::Vector2i windowToGrid(const sf::Vector2i& windowPos) const;
     void runAlgorithm();
+    void stepSearch();
+    void stopSearch();
+    void changeSpeed(bool faster);
+    void seekReplay(size_t position);
+    void scrubReplay(bool forward);
+    void saveTrace();
     void runBenchmark();
     void nextAlgorithm();
     void generateRandomMaze();
@@ -94,4 +114,9 @@ private:
     const float BUTTON_PADDING = 10.f;
     const float DROPDOWN_WIDTH = 200.f;
     const float DROPDOWN_ITEM_HEIGHT = 30.f;
+    const double BENCHMARK_QUERY_BUDGET_MS = 2000.0;
+    const size_t MAX_STEPS_PER_FRAME = 1 << 20;
+    const size_t MAX_TRACE_EVENTS = size_t(1) << 24;
+    const float ZOOM_STEP = 1.2f;
+    const float MIN_VISIBLE_CELLS = 8.f;
 }; 
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <string>
+#include <cstdint>
 #include <SFML/Graphics.hpp>
 
 class Maze {
@@ -17,7 +18,22 @@ public:
         }
     };
 
-    enum class CellType {
+    // Axis-aligned block of cells, used to report which part of the grid changed
+    struct Rect {
+        int x, y, width, height;
+        Rect(int x = 0, int y = 0, int width = 0, int height = 0)
+            : x(x), y(y), width(width), height(height) {}
+        bool empty() const { return width <= 0 || height <= 0; }
+        bool contains(int px, int py) const {
+            return px >= x && px < x + width && py >= y && py < y + height;
+        }
+        // Grow to the bounding box of this rectangle and the given one
+        void include(const Rect& other);
+    };
+
+    // Stored as one byte per cell. PATH, WALL, START and GOAL describe the
+    // terrain; VISITED and PATH_FOUND only ever live in the search overlay.
+    enum class CellType : std::uint8_t {
         PATH,
         WALL,
         START,
@@ -26,6 +42,12 @@ public:
         PATH_FOUND
     };
 
+    // Neighbour directions in the bit order used by getNeighborMask():
+    // down, right, up, left, then down-right, down-left, up-right, up-left
+    static constexpr int DIRECTION_COUNT = 8;
+    static constexpr int DIRECTION_DX[DIRECTION_COUNT] = {0, 1, 0, -1, 1, -1, 1, -1};
+    static constexpr int DIRECTION_DY[DIRECTION_COUNT] = {1, 0, -1, 0, 1, 1, -1, -1};
+
     Maze();
     ~Maze() = default;
 
@@ -38,38 +60,173 @@ public:
     void resize(int width, int height);
     void setCellType(int x, int y, CellType type);
     CellType getCellType(int x, int y) const;
+    CellType getTerrain(int x, int y) const;
     void clear();
     void generateRandom(int width, int height, float wallDensity);
 
+    // Batched editing. Edits made between beginEdit() and the matching
+    // commit() are coalesced; commit() returns the bounding box of every
+    // terrain cell changed since beginEdit(). Calls may nest, in which case
+    // only the outermost commit() reports the region. Edits made outside a
+    // batch behave as if each one were committed on its own.
+    void beginEdit();
+    Rect commit();
+    void fillRect(const Rect& area, CellType type);
+
+    // Incremented once per committed batch that changed the terrain
+    std::uint64_t getRevision() const { return revision_; }
+
+    // Identifies which cells are walkable. A committed batch that turned a
+    // cell from walkable to wall or back draws a new stamp, never used by
+    // any maze before; moving the start or goal keeps it. Copies share the
+    // stamp until one of them is edited, so per-map preprocessing can be
+    // keyed on it alone.
+    std::uint64_t getWalkabilityStamp() const { return walkabilityStamp_; }
+
+    // Where walkability may have changed since an earlier stamp of this
+    // maze: area becomes the bounding box of those batches (empty when the
+    // stamp is current). Returns false when the stamp is unknown, because it
+    // is too old, belongs to another maze or predates a resize; the caller
+    // then has to start from scratch.
+    bool getWalkabilityChanges(std::uint64_t sinceStamp, Rect& area) const;
+
+    // Search overlay (VISITED / PATH_FOUND), kept apart from the terrain so
+    // that a new run only has to reset the cells the previous run touched
+    void setOverlay(int x, int y, CellType type);
+    CellType getOverlay(int x, int y) const;
+    void clearOverlay();
+
+    // Cells whose displayed type (terrain or overlay) may have changed since
+    // the last call, possibly repeated, for a renderer that redraws only
+    // those. Returns true instead of listing them when the whole grid has
+    // to be redrawn: after a resize or a bulk edit, or once the changes
+    // outnumber a quarter of the cells.
+    bool takeDisplayChanges(std::vector<int>& cells);
+
     // Getters
     int getWidth() const { return width_; }
     int getHeight() const { return height_; }
     Point getStart() const { return start_; }
     Point getGoal() const { return goal_; }
-    bool isValidCell(int x, int y) const;
-    bool isWalkable(int x, int y) const;
+    bool isValidCell(int x, int y) const {
+        return x >= 0 && x < width_ && y >= 0 && y < height_;
+    }
+    bool isWalkable(int x, int y) const {
+        return isValidCell(x, y) && terrain_[index(x, y)] != CellType::WALL;
+    }
+
+    // Unchecked walkability test. The grid is mirrored into a copy padded
+    // with a one-cell wall border, so any cell inside the grid or directly
+    // next to it may be queried without a bounds check.
+    bool isPassable(int x, int y) const {
+        return passable_[static_cast<size_t>(y + 1) * (width_ + 2) + (x + 1)] != 0;
+    }
+
+    // Bit d is set when the neighbour in DIRECTION_DX/DY[d] is walkable.
+    // Masks and the padded grid are refreshed by the outermost commit(), so
+    // they lag behind terrain edits made inside an open batch.
+    std::uint8_t getNeighborMask(int index) const { return neighborMask_[index]; }
+
+    // Walkability packed 64 cells to a word, as one bit line per row and one
+    // per column (the transposed grid), for block-based scans. Cell x of a
+    // row line (y of a column line) is bit BITMAP_OFFSET + x. Each line
+    // starts and ends with a zero word and includes the wall border, so a
+    // 64-bit window may be read anywhere within one word of the cells, and
+    // lines -1 and width/height exist and read as blocked. Refreshed by
+    // commit() together with the masks.
+    static constexpr int BITMAP_OFFSET = 65;
+    const std::uint64_t* getRowBits(int y) const {
+        return rowBits_.data() + static_cast<size_t>(y + 1) * rowWords_;
+    }
+    const std::uint64_t* getColumnBits(int x) const {
+        return columnBits_.data() + static_cast<size_t>(x + 1) * columnWords_;
+    }
+    size_t getRowWords() const { return rowWords_; }
+
+    // Connected components of the walkable cells under the eight-way moves
+    // of getNeighborMask(), so cells with different components can never be
+    // joined by any search. Maintained by commit() like the masks: small
+    // edits are patched in place, anything else relabels the grid with a
+    // union-find run over row strips in parallel. Component ids are only
+    // good for comparison and may change with any edit; walls have
+    // NO_COMPONENT.
+    static constexpr int NO_COMPONENT = -1;
+    int getComponent(int x, int y) const {
+        if (!isValidCell(x, y)) return NO_COMPONENT;
+        int label = component_[index(x, y)];
+        if (label == NO_COMPONENT) return label;
+        while (labelParent_[label] != label) label = labelParent_[label];
+        return label;
+    }
+    bool areConnected(const Point& a, const Point& b) const {
+        const int component = getComponent(a.x, a.y);
+        return component != NO_COMPONENT && component == getComponent(b.x, b.y);
+    }
 
-    // SFML rendering
-    void draw(sf::RenderWindow& window, float cellSize) const;
+    // Row-major cell indexing shared with the pathfinders
+    int index(int x, int y) const { return y * width_ + x; }
+    Point pointAt(int index) const { return Point(index % width_, index / width_); }
+    const CellType* terrainData() const { return terrain_.data(); }
 
 private:
-    std::vector<std::vector<CellType>> grid_;
+    std::vector<CellType> terrain_;        // row-major, width_ * height_
+    std::vector<CellType> overlay_;        // PATH means "no overlay"
+    std::vector<int> overlayCells_;        // indices with a non-empty overlay
+    std::vector<int> displayChanges_;      // for takeDisplayChanges()
+    bool displayAll_;
+    std::vector<std::uint8_t> passable_;   // (width_ + 2) * (height_ + 2), wall border
+    std::vector<std::uint8_t> neighborMask_; // row-major, width_ * height_
+    std::vector<std::uint64_t> rowBits_;     // height_ + 2 lines of rowWords_
+    std::vector<std::uint64_t> columnBits_;  // width_ + 2 lines of columnWords_
+    std::vector<int> component_;             // row-major label, NO_COMPONENT for walls
+    std::vector<int> labelParent_;           // labels merged by later edits point to their root
+    size_t rowWords_;
+    size_t columnWords_;
     int width_;
     int height_;
     Point start_;
     Point goal_;
 
+    // Edit batching state
+    int editDepth_;
+    Rect pendingDirty_;
+    std::uint64_t revision_;
+    std::uint64_t walkabilityStamp_;
+
+    // Recent walkability changes, oldest first, for incremental consumers
+    struct WalkabilityChange {
+        std::uint64_t fromStamp;
+        Rect area;
+    };
+    static constexpr size_t WALKABILITY_JOURNAL_SIZE = 64;
+    std::vector<WalkabilityChange> walkabilityJournal_;
+
+    // Cells whose walkability the pending commit() flipped. Past
+    // MAX_COMPONENT_PATCH cells the components are rebuilt instead.
+    static constexpr size_t MAX_COMPONENT_PATCH = 1024;
+    std::vector<int> flippedCells_;
+    bool componentsStale_;
+
     // Helper functions
     void validatePoint(const Point& p) const;
-    void updateStartGoal();
+    void writeTerrain(int x, int y, CellType type);
+    void markDirty(const Rect& area);
+    void markDisplayChanged(int index);
+    bool refreshWalkability(const Rect& area);
+    void updateComponents();
+    bool splitsComponents(std::vector<int>& boundary);
+    void rebuildComponents();
+    CellType displayType(int index) const;
 };
 
-// Hash function for Point to use in unordered containers
+// Hash function for Point to use in unordered containers. Both coordinates
+// are packed into one 64-bit key so neighbouring cells never collide.
 namespace std {
     template<>
     struct hash<Maze::Point> {
         size_t operator()(const Maze::Point& p) const {
-            return hash<int>()(p.x) ^ (hash<int>()(p.y) << 1);
+            return hash<uint64_t>()((static_cast<uint64_t>(static_cast<uint32_t>(p.x)) << 32) |
+                                    static_cast<uint32_t>(p.y));
         }
     };
 } 
\ No newline at end of file
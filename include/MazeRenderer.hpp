@@ -0,0 +1,100 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include "Maze.hpp"
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+// Draws a maze as textures cut into square tiles and scaled up to the cell
+// size, so a frame costs one draw call per visible tile however large the
+// maze is. Only tiles in view are built, on first sight, and kept in a
+// bounded cache.
+//
+// Level 0 has one texel per cell. Level L has one texel per 2^L x 2^L block
+// of cells, shaded by the block's wall density and visited share (start,
+// goal and the found path stay in their own colours). The view picks the
+// level at which a texel covers about one screen pixel, so the work per
+// frame follows the pixels on screen rather than the cells in the maze.
+// Blocks of four cells and more are summarised in a pyramid kept beside
+// the maze, built the first time the view zooms out that far and then
+// patched cell by cell.
+//
+// update() takes the cells changed since the last frame from the maze and
+// marks the cached tiles holding them; those are rebuilt when next drawn.
+class MazeRenderer {
+public:
+    static constexpr int TILE_SIZE = 256;  // texels per tile side
+    static constexpr int MAX_LEVEL = 15;
+    static constexpr size_t MAX_TILES = 192;  // 48 MB of textures
+
+    // Grid lines are drawn in the background colour once cells are at
+    // least MIN_GRID_CELL_SIZE pixels wide, as gaps between the cells
+    explicit MazeRenderer(sf::Color gridColor = sf::Color(50, 50, 50));
+
+    // Takes in the maze's display changes
+    void update(Maze& maze);
+
+    // Draws the part of the maze inside the target's current view, with
+    // cells cellSize view units wide
+    void draw(sf::RenderTarget& target, const Maze& maze, float cellSize);
+
+    // Brings the level's tiles covering a block of cells up to date and
+    // marks them used this frame. Returns how many tiles were rebuilt.
+    size_t prepare(const Maze& maze, const Maze::Rect& cells, int level);
+
+    // Level whose texels come closest to one screen pixel, from above
+    static int levelFor(float pixelsPerCell);
+
+    size_t getTileCount() const { return tiles_.size(); }
+
+    static sf::Color colorOf(Maze::CellType type);
+
+private:
+    static constexpr float MIN_GRID_CELL_SIZE = 4.f;
+    static constexpr int FIRST_PYRAMID_LEVEL = 2;
+
+    // Summary of a block of cells: fractions out of 255 and flags
+    struct Block {
+        std::uint8_t walls = 0;
+        std::uint8_t visited = 0;  // VISITED and PATH_FOUND overlay
+        std::uint8_t flags = 0;
+    };
+    enum : std::uint8_t { HAS_PATH = 1, HAS_START = 2, HAS_GOAL = 4 };
+
+    struct Tile {
+        sf::Texture texture;
+        bool dirty = true;
+        std::uint64_t lastUsed = 0;
+    };
+
+    sf::Color gridColor_;
+    sf::Color visitedColor_;  // VISITED as it shows over the background
+    int width_ = 0;
+    int height_ = 0;
+    int topLevel_ = 0;  // first level that is a single texel
+    std::uint64_t frame_ = 0;
+    std::unordered_map<std::uint64_t, Tile> tiles_;  // by level and tile position
+    std::vector<std::vector<Block>> pyramid_;         // by level, row-major; empty below FIRST_PYRAMID_LEVEL
+    bool pyramidStale_ = true;
+    std::vector<std::uint8_t> pixels_;  // RGBA staging for one tile
+    std::vector<int> changes_;
+    sf::VertexArray grid_;
+
+    static std::uint64_t tileKey(int level, int tx, int ty) {
+        return (static_cast<std::uint64_t>(level) << 56) | (static_cast<std::uint64_t>(ty) << 28) |
+               static_cast<std::uint64_t>(tx);
+    }
+    static int levelSize(int cells, int level) { return (cells + (1 << level) - 1) >> level; }
+
+    void resize(int width, int height);
+    void rebuild(const Maze& maze, int level, int tx, int ty, Tile& tile);
+    void evict();
+
+    Block blockAt(const Maze& maze, int level, int x, int y) const;
+    Block summarizeCells(const Maze& maze, int x0, int y0, int size) const;
+    Block summarizeChildren(int level, int x, int y) const;
+    void buildPyramid(const Maze& maze);
+    void patchPyramid(const Maze& maze, int cell);
+    sf::Color shade(const Block& block) const;
+};
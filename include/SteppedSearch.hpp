@@ -0,0 +1,113 @@
+#pragma once
+
+#include "pathfinders/Pathfinder.hpp"
+#include "Maze.hpp"
+#include <vector>
+#include <memory>
+#include <bits/stdc++.h>
+
+// One query of any Pathfinder run as a resumable search. The search runs on
+// a thread of its own and parks at every visualised step until its owner
+// lets it go on; the owner calls advance(n) whenever it likes (the GUI does
+// so once per frame) to allow n more steps and collect the ones taken so
+// far. advance() never waits for the search, so the owner stays responsive
+// at any stepping speed.
+//
+// Every Pathfinder already reports its steps through the visualisation
+// callback, so no algorithm needs a hand-written state machine, and
+// headless queries keep their callback-free path untouched.
+//
+// Without visualisation the query runs through unparked at full speed, off
+// the owner's thread; a trace attached to the pathfinder then records it
+// for replay (TraceReplay.hpp).
+//
+// The maze must not be edited while the search is running: the search reads
+// it without locks. Destroying the object cancels the search through the
+// pathfinder's cancellation limit and waits for the thread to finish. A
+// token the pathfinder's limits already carried still cancels the search.
+class SteppedSearch {
+public:
+    struct Step {
+        Maze::Point current;
+        std::vector<Maze::Point> path;  // route to current, where the algorithm reports one
+    };
+
+    SteppedSearch(Pathfinder& pathfinder, const Maze& maze, const Maze::Point& start, const Maze::Point& goal,
+                  bool visualize = true)
+        : pathfinder_(pathfinder), visualize_(visualize), previousLimits_(pathfinder.getLimits()),
+          token_(std::make_shared<Pathfinder::CancellationToken>(previousLimits_.cancellation)) {
+        Pathfinder::SearchLimits limits = previousLimits_;
+        limits.cancellation = token_;
+        pathfinder_.setLimits(limits);
+        thread_ = std::thread([this, &maze, start, goal] { work(maze, start, goal); });
+    }
+
+    ~SteppedSearch() {
+        cancel();
+        thread_.join();
+    }
+
+    SteppedSearch(const SteppedSearch&) = delete;
+    SteppedSearch& operator=(const SteppedSearch&) = delete;
+
+    // Allows `steps` more steps and returns those taken since the last call
+    std::vector<Step> advance(size_t steps) {
+        std::vector<Step> taken;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            allowance_ += steps;
+            taken.swap(pending_);
+        }
+        resume_.notify_one();
+        return taken;
+    }
+
+    // Stops the search at its next limit check; it no longer waits for steps
+    void cancel() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cancelled_ = true;
+        }
+        token_->cancel();
+        resume_.notify_one();
+    }
+
+    bool finished() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return finished_;
+    }
+
+    // The query's result, once finished() (steps may still be pending)
+    const Pathfinder::PathfindingResult& result() const { return result_; }
+
+private:
+    Pathfinder& pathfinder_;
+    bool visualize_;
+    Pathfinder::SearchLimits previousLimits_;
+    std::shared_ptr<Pathfinder::CancellationToken> token_;
+    std::thread thread_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable resume_;
+    size_t allowance_ = 0;
+    bool cancelled_ = false;
+    bool finished_ = false;
+    std::vector<Step> pending_;
+    Pathfinder::PathfindingResult result_;
+
+    void work(const Maze& maze, const Maze::Point& start, const Maze::Point& goal) {
+        auto onStep = [this](const Maze::Point& current, const std::vector<Maze::Point>& path) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            resume_.wait(lock, [this] { return allowance_ > 0 || cancelled_; });
+            if (cancelled_) return;
+            --allowance_;
+            pending_.push_back(Step{current, path});
+        };
+        Pathfinder::PathfindingResult result = pathfinder_.findPath(maze, start, goal, visualize_, onStep);
+        pathfinder_.setLimits(previousLimits_);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        result_ = std::move(result);
+        finished_ = true;
+    }
+};
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <bits/stdc++.h>
+
+// Fixed set of worker threads for index-parallel jobs. run() hands every
+// worker one contiguous range of the indices; a worker takes indices from
+// the front of its own range and, once that is empty, steals the back half
+// of the largest range left, so uneven task costs even out without every
+// index going through a shared queue.
+class WorkStealingPool {
+public:
+    using Task = std::function<void(size_t index, unsigned worker)>;
+
+    // threads == 0 uses every hardware thread
+    explicit WorkStealingPool(unsigned threads = 0) {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        ranges_.reset(new Range[threads]);
+        for (unsigned worker = 0; worker < threads; ++worker) {
+            threads_.emplace_back([this, worker] { work(worker); });
+        }
+    }
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& thread : threads_) thread.join();
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(threads_.size()); }
+
+    // Calls task(index, worker) for every index in [0, count) and returns
+    // once all calls have finished. The first exception a task throws is
+    // rethrown here after the others complete. One job runs at a time.
+    void run(size_t count, const Task& task) {
+        if (count == 0) return;
+        const size_t workers = threads_.size();
+        for (size_t worker = 0; worker < workers; ++worker) {
+            std::lock_guard<std::mutex> lock(ranges_[worker].lock);
+            ranges_[worker].begin = count * worker / workers;
+            ranges_[worker].end = count * (worker + 1) / workers;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        task_ = &task;
+        error_ = nullptr;
+        active_ = static_cast<unsigned>(workers);
+        ++job_;
+        wake_.notify_all();
+        finished_.wait(lock, [this] { return active_ == 0; });
+        task_ = nullptr;
+        if (error_) std::rethrow_exception(error_);
+    }
+
+private:
+    struct Range {
+        std::mutex lock;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    std::vector<std::thread> threads_;
+    std::unique_ptr<Range[]> ranges_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable finished_;
+    const Task* task_ = nullptr;
+    std::exception_ptr error_;
+    std::uint64_t job_ = 0;
+    unsigned active_ = 0;
+    bool stopping_ = false;
+
+    void work(unsigned worker) {
+        std::uint64_t lastJob = 0;
+        for (;;) {
+            const Task* task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&] { return stopping_ || job_ != lastJob; });
+                if (stopping_) return;
+                lastJob = job_;
+                task = task_;
+            }
+
+            size_t index;
+            while (take(worker, index)) {
+                try {
+                    (*task)(index, worker);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (!error_) error_ = std::current_exception();
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--active_ == 0) finished_.notify_all();
+        }
+    }
+
+    bool take(unsigned worker, size_t& index) {
+        Range& own = ranges_[worker];
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> lock(own.lock);
+                if (own.begin < own.end) {
+                    index = own.begin++;
+                    return true;
+                }
+            }
+            if (!steal(worker)) return false;
+        }
+    }
+
+    // Moves the back half of the largest other range into the thief's own.
+    // The victim may drain its range between the scan and the split, in
+    // which case the scan starts over.
+    bool steal(unsigned thief) {
+        for (;;) {
+            unsigned victim = thief;
+            size_t largest = 0;
+            for (unsigned worker = 0; worker < threads_.size(); ++worker) {
+                if (worker == thief) continue;
+                std::lock_guard<std::mutex> lock(ranges_[worker].lock);
+                const size_t remaining = ranges_[worker].end - ranges_[worker].begin;
+                if (remaining > largest) {
+                    largest = remaining;
+                    victim = worker;
+                }
+            }
+            if (victim == thief) return false;
+
+            size_t begin, end;
+            {
+                std::lock_guard<std::mutex> lock(ranges_[victim].lock);
+                Range& range = ranges_[victim];
+                if (range.begin >= range.end) continue;
+                end = range.end;
+                begin = range.begin + (range.end - range.begin) / 2;
+                range.end = begin;
+            }
+            std::lock_guard<std::mutex> lock(ranges_[thief].lock);
+            ranges_[thief].begin = begin;
+            ranges_[thief].end = end;
+            return true;
+        }
+    }
+};
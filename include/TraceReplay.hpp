@@ -0,0 +1,98 @@
+#pragma once
+
+#include "pathfinders/SearchTrace.hpp"
+#include "Maze.hpp"
+#include <vector>
+#include <bits/stdc++.h>
+
+// Plays a SearchTrace back at any speed, forwards and backwards. The replay
+// keeps the search tree and the expanded cells as they were after the first
+// position() events; seek() applies the events in between or undoes them,
+// so moving by n events costs O(n) whatever the length of the trace.
+//
+// Paths are rebuilt from the tree only when asked for. A trace whose ring
+// wrapped starts at its oldest kept event: parents set before it are
+// unknown, and paths through those cells stop short of the start.
+class TraceReplay {
+public:
+    static constexpr int NO_PARENT = -1;
+
+    explicit TraceReplay(const SearchTrace& trace)
+        : trace_(trace),
+          width_(trace.getWidth()),
+          parents_(static_cast<size_t>(trace.getWidth()) * trace.getHeight(), NO_PARENT),
+          expansions_(parents_.size(), 0),
+          previous_(trace.size(), NO_PARENT) {}
+
+    size_t position() const { return position_; }
+    size_t length() const { return trace_.size(); }
+    bool atEnd() const { return position_ == length(); }
+
+    // Moves to just after the first `target` events (clamped to the trace)
+    void seek(size_t target) {
+        target = std::min(target, length());
+        changed_.clear();
+        for (; position_ < target; ++position_) {
+            const SearchTrace::Event& event = trace_[position_];
+            if (event.isExpansion()) {
+                if (expansions_[event.cell]++ == 0) changed_.push_back(event.cell);
+                current_ = event.cell;
+            } else {
+                previous_[position_] = parents_[event.cell];
+                parents_[event.cell] = event.parent;
+            }
+        }
+        bool undoneCurrent = false;
+        for (; position_ > target; --position_) {
+            const SearchTrace::Event& event = trace_[position_ - 1];
+            if (event.isExpansion()) {
+                if (--expansions_[event.cell] == 0) changed_.push_back(event.cell);
+                undoneCurrent = true;
+            } else {
+                parents_[event.cell] = previous_[position_ - 1];
+            }
+        }
+
+        // The expansion before the new position, if the old one was undone
+        if (undoneCurrent) {
+            current_ = NO_PARENT;
+            for (size_t i = position_; i > 0; --i) {
+                if (trace_[i - 1].isExpansion()) {
+                    current_ = trace_[i - 1].cell;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Cells whose expanded() changed in the last seek()
+    const std::vector<int>& changedCells() const { return changed_; }
+
+    bool expanded(int cell) const { return expansions_[cell] != 0; }
+    unsigned expansionCount(int cell) const { return expansions_[cell]; }
+    int parent(int cell) const { return parents_[cell]; }
+
+    // Cell of the latest expansion replayed, or NO_PARENT before the first
+    int current() const { return current_; }
+
+    // Route to a cell through the tree as it stands at this position
+    std::vector<Maze::Point> pathTo(int cell) const {
+        std::vector<Maze::Point> path;
+        for (size_t steps = 0; cell != NO_PARENT && steps < parents_.size(); ++steps) {
+            path.push_back(Maze::Point(cell % width_, cell / width_));
+            cell = parents_[cell];
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+
+private:
+    const SearchTrace& trace_;
+    int width_;
+    size_t position_ = 0;
+    int current_ = NO_PARENT;
+    std::vector<int> parents_;
+    std::vector<unsigned> expansions_;
+    std::vector<int> previous_;  // parent each replayed parent event replaced
+    std::vector<int> changed_;
+};
@@ -0,0 +1,336 @@
+#pragma once
+
+#include "Pathfinder.hpp"
+#include "OpenList.hpp"
+#include "CostModel.hpp"
+#include "Heuristic.hpp"
+#include "Neighborhood.hpp"
+#include "Bits.hpp"
+#include "../ThreadPool.hpp"
+#include <bits/stdc++.h>
+
+// Landmark distance tables for ALT (Goldberg & Harrelson, "Computing the
+// Shortest Path: A* Search Meets Graph Theory", SODA 2005). For a landmark L
+// the triangle inequality gives d(n, g) >= |d(L, n) - d(L, g)|, which on
+// maze-like maps is far closer to the true distance than any straight-line
+// bound.
+//
+// Landmarks are picked by farthest-point selection inside the largest
+// component: the first is the cell farthest from an arbitrary seed, each
+// further one the cell farthest from all landmarks so far. Selection uses
+// unit-step distances grown only into cells the new landmark is closer to.
+// The octile distance tables are then built one landmark per worker.
+//
+// Distances are stored as 16 bits per landmark and cell, cell-major so the
+// entries one estimate reads share a cache line. A landmark whose distances
+// exceed the 16-bit range stores them divided by a scale; the truncation is
+// taken out of the bound, which stays admissible but may lose consistency.
+class LandmarkTable {
+public:
+    using Cost = OctileCost::Cost;
+
+    // Entry of cells the landmark cannot reach
+    static constexpr std::uint16_t UNREACHED = UINT16_MAX;
+
+    explicit LandmarkTable(unsigned landmarks = 16, unsigned threads = 0)
+        : requested_(std::max(1u, landmarks)), threads_(threads) {}
+
+    // Rebuild when the walls changed since the tables were built
+    void update(const Maze& maze) {
+        if (stamp_ != maze.getWalkabilityStamp()) {
+            build(maze);
+        }
+    }
+
+    void build(const Maze& maze) {
+        cellCount_ = static_cast<size_t>(maze.getWidth()) * maze.getHeight();
+        selectLandmarks(maze);
+        buildTables(maze);
+        stamp_ = maze.getWalkabilityStamp();
+    }
+
+    const std::vector<Maze::Point>& getLandmarks() const { return landmarks_; }
+    size_t landmarkCount() const { return landmarks_.size(); }
+    std::uint64_t getWalkabilityStamp() const { return stamp_; }
+
+    // Entries of one cell, landmarkCount() of them
+    const std::uint16_t* entries(int index) const {
+        return table_.data() + static_cast<size_t>(index) * landmarks_.size();
+    }
+
+    // Largest landmark bound on the cost between two cells whose entries
+    // are given; 0 when no landmark reaches them
+    Cost bound(const std::uint16_t* from, const std::uint16_t* to) const {
+        Cost best = 0;
+        for (size_t k = 0; k < landmarks_.size(); ++k) {
+            if (from[k] == UNREACHED || to[k] == UNREACHED) continue;
+            const Cost difference = std::abs(static_cast<Cost>(from[k]) - static_cast<Cost>(to[k]));
+            best = std::max(best, difference * scale_[k] - (scale_[k] - 1));
+        }
+        return best;
+    }
+
+    size_t memoryUsage() const {
+        return table_.capacity() * sizeof(std::uint16_t) + scale_.capacity() * sizeof(Cost);
+    }
+
+private:
+    unsigned requested_;
+    unsigned threads_;
+    std::uint64_t stamp_ = 0;
+    size_t cellCount_ = 0;
+    std::vector<Maze::Point> landmarks_;
+    std::vector<Cost> scale_;           // per landmark, 1 unless distances overflow 16 bits
+    std::vector<std::uint16_t> table_;  // cell * landmarkCount() + landmark
+
+    // Farthest-point selection over the largest component
+    void selectLandmarks(const Maze& maze) {
+        landmarks_.clear();
+
+        std::unordered_map<int, size_t> sizes;
+        int seed = -1;
+        size_t largest = 0;
+        for (size_t cell = 0; cell < cellCount_; ++cell) {
+            const Maze::Point p = maze.pointAt(static_cast<int>(cell));
+            const int component = maze.getComponent(p.x, p.y);
+            if (component == Maze::NO_COMPONENT) continue;
+            if (++sizes[component] > largest) {
+                largest = sizes[component];
+                seed = static_cast<int>(cell);
+            }
+        }
+        if (seed < 0) return;
+
+        // Distance of every cell to its closest landmark so far
+        std::vector<int> closest(cellCount_, std::numeric_limits<int>::max());
+        std::vector<int> queue;
+        const int first = farthest(maze, closest, queue, seed);
+        std::fill(closest.begin(), closest.end(), std::numeric_limits<int>::max());
+
+        int next = first;
+        while (landmarks_.size() < requested_ && next >= 0) {
+            landmarks_.push_back(maze.pointAt(next));
+            next = farthest(maze, closest, queue, next);
+        }
+    }
+
+    // Grows unit-step distances from a new landmark into the cells it is
+    // closer to than every earlier one, then returns the reached cell
+    // farthest from all of them (-1 once every cell is a landmark)
+    int farthest(const Maze& maze, std::vector<int>& closest, std::vector<int>& queue, int source) const {
+        const int width = maze.getWidth();
+        int offsets[EightNeighborhood::COUNT];
+        for (int d = 0; d < EightNeighborhood::COUNT; ++d) {
+            offsets[d] = EightNeighborhood::DY[d] * width + EightNeighborhood::DX[d];
+        }
+
+        closest[source] = 0;
+        queue.assign(1, source);
+        for (size_t head = 0; head < queue.size(); ++head) {
+            const int current = queue[head];
+            const int distance = closest[current] + 1;
+            unsigned mask = maze.getNeighborMask(current);
+            for (; mask != 0; mask &= mask - 1) {
+                const int neighbor = current + offsets[countTrailingZeros(static_cast<std::uint32_t>(mask))];
+                if (distance >= closest[neighbor]) continue;
+                closest[neighbor] = distance;
+                queue.push_back(neighbor);
+            }
+        }
+
+        int best = -1;
+        int bestDistance = 0;
+        for (size_t cell = 0; cell < cellCount_; ++cell) {
+            if (closest[cell] != std::numeric_limits<int>::max() && closest[cell] > bestDistance) {
+                bestDistance = closest[cell];
+                best = static_cast<int>(cell);
+            }
+        }
+        return best;
+    }
+
+    // One Dijkstra per landmark on the worker pool into landmark-major
+    // staging, then a parallel transpose into the cell-major table
+    void buildTables(const Maze& maze) {
+        const size_t count = landmarks_.size();
+        scale_.assign(count, 1);
+        table_.assign(cellCount_ * count, UNREACHED);
+        if (count == 0) return;
+
+        WorkStealingPool pool(static_cast<unsigned>(std::min<size_t>(
+            threads_ != 0 ? threads_ : std::max(1u, std::thread::hardware_concurrency()), count)));
+        std::vector<std::vector<Cost>> distances(pool.size());
+        std::vector<BucketQueue<Cost, OctileCost::MAX_STEP>> queues(pool.size());
+        std::vector<std::uint16_t> staging(cellCount_ * count);
+        pool.run(count, [&](size_t k, unsigned worker) {
+            std::vector<Cost>& distance = distances[worker];
+            const Cost longest = dijkstra(maze, landmarks_[k], distance, queues[worker]);
+            const Cost scale = longest / (UNREACHED - 1) + 1;
+            scale_[k] = scale;
+            std::uint16_t* column = staging.data() + k * cellCount_;
+            for (size_t cell = 0; cell < cellCount_; ++cell) {
+                column[cell] = distance[cell] == std::numeric_limits<Cost>::max()
+                                   ? UNREACHED
+                                   : static_cast<std::uint16_t>(distance[cell] / scale);
+            }
+        });
+
+        constexpr size_t BLOCK = 1 << 14;
+        pool.run((cellCount_ + BLOCK - 1) / BLOCK, [&](size_t block, unsigned) {
+            const size_t end = std::min(cellCount_, (block + 1) * BLOCK);
+            for (size_t cell = block * BLOCK; cell < end; ++cell) {
+                for (size_t k = 0; k < count; ++k) {
+                    table_[cell * count + k] = staging[k * cellCount_ + cell];
+                }
+            }
+        });
+    }
+
+    // Octile distances from a landmark; returns the largest one reached
+    Cost dijkstra(const Maze& maze, const Maze::Point& source, std::vector<Cost>& distance,
+                  BucketQueue<Cost, OctileCost::MAX_STEP>& open) const {
+        int offsets[EightNeighborhood::COUNT];
+        for (int d = 0; d < EightNeighborhood::COUNT; ++d) {
+            offsets[d] = EightNeighborhood::DY[d] * maze.getWidth() + EightNeighborhood::DX[d];
+        }
+
+        distance.assign(cellCount_, std::numeric_limits<Cost>::max());
+        open.reset(cellCount_);
+        const int sourceIndex = maze.index(source.x, source.y);
+        distance[sourceIndex] = 0;
+        open.push(sourceIndex, 0);
+        Cost longest = 0;
+        while (!open.empty()) {
+            const int current = open.pop();
+            longest = distance[current];
+            unsigned mask = maze.getNeighborMask(current);
+            for (; mask != 0; mask &= mask - 1) {
+                const int d = countTrailingZeros(static_cast<std::uint32_t>(mask));
+                const int neighbor = current + offsets[d];
+                const Cost next = distance[current] + OctileCost::step(EightNeighborhood::DX[d], EightNeighborhood::DY[d]);
+                if (next < distance[neighbor]) {
+                    distance[neighbor] = next;
+                    open.pushOrDecrease(neighbor, next);
+                }
+            }
+        }
+        return longest;
+    }
+};
+
+// Integer octile A* guided by the larger of the octile distance and the
+// landmark bound. Tables are built by prepare() or on the first query after
+// the maze changes. Cells may be reopened, since scaled landmark bounds are
+// not always consistent.
+class ALTAStar : public Pathfinder {
+public:
+    explicit ALTAStar(unsigned landmarks = 16, unsigned threads = 0)
+        : landmarks_(std::make_shared<LandmarkTable>(landmarks, threads)) {}
+
+    void prepare(const Maze& maze) override {
+        landmarks_->update(maze);
+    }
+
+    bool sharePreprocessing(const Pathfinder& source) override {
+        const auto* other = dynamic_cast<const ALTAStar*>(&source);
+        if (other == nullptr || other == this) return false;
+        landmarks_ = other->landmarks_;
+        return true;
+    }
+
+    const LandmarkTable& getLandmarkTable() const { return *landmarks_; }
+
+    std::string getName() const override {
+        return "A* (ALT landmarks)";
+    }
+
+protected:
+    PathfindingResult search(const Maze& maze, const Maze::Point& start, const Maze::Point& goal,
+                             bool visualize, VisualizationCallback callback) override {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        PathfindingResult result;
+
+        if (!hasValidEndpoints(maze, start, goal) || !mayBeReachable(maze, start, goal)) return result;
+
+        landmarks_->update(maze);
+
+        const int startIndex = maze.index(start.x, start.y);
+        const int goalIndex = maze.index(goal.x, goal.y);
+        const size_t cellCount = static_cast<size_t>(maze.getWidth()) * maze.getHeight();
+        open_.reset(cellCount);
+        state_.reset(cellCount);
+
+        int offsets[EightNeighborhood::COUNT];
+        for (int d = 0; d < EightNeighborhood::COUNT; ++d) {
+            offsets[d] = EightNeighborhood::DY[d] * maze.getWidth() + EightNeighborhood::DX[d];
+        }
+
+        // The goal's entries are read by every estimate, so keep them apart
+        const size_t count = landmarks_->landmarkCount();
+        goalEntries_.assign(landmarks_->entries(goalIndex), landmarks_->entries(goalIndex) + count);
+
+        state_.open(startIndex, 0, BasicSearchState<Cost>::NO_PARENT);
+        open_.push(startIndex, PreferLargerG::key(estimate(maze, startIndex, goal), Cost(0)));
+
+        while (!open_.empty()) {
+            if (limitReached(result.nodesExplored)) {
+                result.path = partialPath(state_, maze);
+                break;
+            }
+
+            const int currentIndex = open_.pop();
+            const Cost currentG = state_.cost(currentIndex);
+            state_.close(currentIndex);
+            result.nodesExplored++;
+            traceExpansion(currentIndex);
+            noteExpansion(maze, currentIndex);
+
+            if (visualize) {
+                visualizeStep(maze.pointAt(currentIndex), reconstructPath(state_, maze, currentIndex), visualize, callback);
+            }
+
+            if (currentIndex == goalIndex) {
+                result.path = reconstructPath(state_, maze, goalIndex);
+                break;
+            }
+
+            unsigned mask = maze.getNeighborMask(currentIndex);
+            for (; mask != 0; mask &= mask - 1) {
+                const int d = countTrailingZeros(static_cast<std::uint32_t>(mask));
+                const int neighborIndex = currentIndex + offsets[d];
+                const Cost tentativeG = currentG + OctileCost::step(EightNeighborhood::DX[d], EightNeighborhood::DY[d]);
+                if (state_.visited(neighborIndex) && tentativeG >= state_.cost(neighborIndex)) continue;
+                state_.open(neighborIndex, tentativeG, currentIndex);
+                state_.reopen(neighborIndex);
+                traceParent(neighborIndex, currentIndex);
+                open_.pushOrDecrease(neighborIndex,
+                                     PreferLargerG::key(tentativeG + estimate(maze, neighborIndex, goal), tentativeG));
+            }
+        }
+        result.pathLength = result.path.size();
+
+        // Calculate execution time
+        auto end_time = std::chrono::high_resolution_clock::now();
+        result.executionTime = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+
+        // Get memory usage
+        result.memoryUsage = getCurrentMemoryUsage() + state_.memoryUsage() + open_.memoryUsage() +
+                             landmarks_->memoryUsage();
+
+        return result;
+    }
+
+private:
+    using Cost = OctileCost::Cost;
+
+    std::shared_ptr<LandmarkTable> landmarks_;
+    BasicSearchState<Cost> state_;
+    QuadHeap<std::uint64_t> open_;
+    std::vector<std::uint16_t> goalEntries_;
+
+    Cost estimate(const Maze& maze, int index, const Maze::Point& goal) const {
+        const Maze::Point p = maze.pointAt(index);
+        const Cost octile = OctileHeuristic::estimate<Cost>(std::abs(p.x - goal.x), std::abs(p.y - goal.y));
+        return std::max(octile, landmarks_->bound(landmarks_->entries(index), goalEntries_.data()));
+    }
+};
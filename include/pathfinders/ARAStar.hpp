@@ -0,0 +1,203 @@
+#pragma once
+
+#include "Pathfinder.hpp"
+#include "OpenList.hpp"
+#include "CostModel.hpp"
+#include "Heuristic.hpp"
+#include "Neighborhood.hpp"
+#include "Bits.hpp"
+#include <bits/stdc++.h>
+
+// Anytime Repairing A* (Likhachev, Gordon & Thrun, "ARA*: Anytime A* with
+// Provable Bounds on Sub-Optimality", NIPS 2003) over integer octile costs.
+//
+// The first iteration is weighted A* with f = g + epsilon * h, which finds a
+// path quickly whose cost is within epsilon of the optimum. Each further
+// iteration lowers epsilon and continues from the previous one: cells whose
+// g improved after they were expanded (the INCONS set) go back on the open
+// list with the cells still there, so only what the smaller inflation
+// changes is searched again. Every iteration that reaches the goal is
+// recorded as an improvement with the bound
+//
+//   min(epsilon, g(goal) / min over OPEN and INCONS of (g + h))
+//
+// which reaches 1 once the path is optimal.
+//
+// With a time budget, improvement iterations stop at the deadline and the
+// best path so far is returned. The first iteration always completes, so a
+// query on a connected pair never comes back empty.
+class ARAStar : public Pathfinder {
+public:
+    explicit ARAStar(double initialEpsilon = 3.0, double epsilonStep = 0.5, double timeBudgetMs = 0)
+        : initialEpsilon_(std::max(1.0, initialEpsilon)),
+          epsilonStep_(epsilonStep > 0 ? epsilonStep : 0.5),
+          timeBudgetMs_(timeBudgetMs) {}
+
+    // Milliseconds per query for improvements; 0 improves until optimal
+    void setTimeBudget(double milliseconds) { timeBudgetMs_ = milliseconds; }
+    double getTimeBudget() const { return timeBudgetMs_; }
+
+    std::string getName() const override {
+        return "ARA* (anytime, octile)";
+    }
+
+protected:
+    PathfindingResult search(const Maze& maze, const Maze::Point& start, const Maze::Point& goal,
+                             bool visualize, VisualizationCallback callback) override {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        PathfindingResult result;
+
+        if (!hasValidEndpoints(maze, start, goal) || !mayBeReachable(maze, start, goal)) return result;
+
+        const int startIndex = maze.index(start.x, start.y);
+        goalIndex_ = maze.index(goal.x, goal.y);
+        goal_ = goal;
+        const size_t cellCount = static_cast<size_t>(maze.getWidth()) * maze.getHeight();
+        open_.reset(cellCount);
+        state_.reset(cellCount);
+        incons_.clear();
+        closedList_.clear();
+        for (int d = 0; d < EightNeighborhood::COUNT; ++d) {
+            offsets_[d] = EightNeighborhood::DY[d] * maze.getWidth() + EightNeighborhood::DX[d];
+        }
+
+        const auto deadline = start_time + std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+                                               std::chrono::duration<double, std::milli>(timeBudgetMs_));
+        auto elapsed = [&] {
+            return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start_time).count();
+        };
+
+        double epsilon = initialEpsilon_;
+        Cost bestCost = std::numeric_limits<Cost>::max();
+        state_.open(startIndex, 0, BasicSearchState<Cost>::NO_PARENT);
+        open_.push(startIndex, key(maze, startIndex, epsilon));
+
+        for (bool first = true;; first = false) {
+            const bool completed = improvePath(maze, epsilon, first ? nullptr : &deadline, result, visualize, callback);
+            if (!completed || !state_.visited(goalIndex_)) {
+                // Stopped by the query limits before any path was found
+                if (result.improvements.empty() && limitStopped()) result.path = partialPath(state_, maze);
+                break;
+            }
+
+            // Everything still open or inconsistent, needed both for the
+            // bound and to seed the next iteration
+            pending_.clear();
+            while (!open_.empty()) pending_.push_back(open_.pop());
+            pending_.insert(pending_.end(), incons_.begin(), incons_.end());
+            incons_.clear();
+
+            const Cost goalCost = state_.cost(goalIndex_);
+            Cost lowest = goalCost;
+            for (int cell : pending_) {
+                lowest = std::min(lowest, state_.cost(cell) + estimate(maze, cell));
+            }
+            const double bound = std::min(epsilon, lowest > 0 ? static_cast<double>(goalCost) / lowest : 1.0);
+
+            if (goalCost < bestCost || bound < result.suboptimalityBound) {
+                result.path = reconstructPath(state_, maze, goalIndex_);
+                Improvement improvement;
+                improvement.elapsed = elapsed();
+                improvement.bound = bound;
+                improvement.cost = goalCost / static_cast<double>(OctileCost::STRAIGHT);
+                improvement.pathLength = result.path.size();
+                result.improvements.push_back(improvement);
+            }
+            bestCost = goalCost;
+            result.suboptimalityBound = bound;
+
+            if (bound <= 1.0 || epsilon <= 1.0) break;
+            if (timeBudgetMs_ > 0 && std::chrono::high_resolution_clock::now() >= deadline) break;
+
+            // Next iteration: smaller inflation, same g values, all closed
+            // cells open for expansion again
+            epsilon = std::max(1.0, epsilon - epsilonStep_);
+            for (int cell : closedList_) state_.reopen(cell);
+            closedList_.clear();
+            for (int cell : pending_) open_.pushOrDecrease(cell, key(maze, cell, epsilon));
+        }
+        result.pathLength = result.path.size();
+
+        // Calculate execution time
+        auto end_time = std::chrono::high_resolution_clock::now();
+        result.executionTime = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+
+        // Get memory usage
+        result.memoryUsage = getCurrentMemoryUsage() + state_.memoryUsage() + open_.memoryUsage() +
+                             (incons_.capacity() + closedList_.capacity() + pending_.capacity()) * sizeof(int);
+
+        return result;
+    }
+
+private:
+    using Cost = OctileCost::Cost;
+    using Deadline = std::chrono::high_resolution_clock::time_point;
+
+    // Expansions between two looks at the clock
+    static constexpr size_t CLOCK_INTERVAL = 256;
+
+    double initialEpsilon_;
+    double epsilonStep_;
+    double timeBudgetMs_;
+
+    int goalIndex_ = -1;
+    Maze::Point goal_;
+    int offsets_[EightNeighborhood::COUNT] = {};
+    BasicSearchState<Cost> state_;
+    QuadHeap<double> open_;
+    std::vector<int> incons_;      // closed cells whose g dropped, may repeat
+    std::vector<int> closedList_;  // expanded in the current iteration
+    std::vector<int> pending_;
+
+    Cost estimate(const Maze& maze, int index) const {
+        const Maze::Point p = maze.pointAt(index);
+        return OctileHeuristic::estimate<Cost>(std::abs(p.x - goal_.x), std::abs(p.y - goal_.y));
+    }
+
+    double key(const Maze& maze, int index, double epsilon) const {
+        return state_.cost(index) + epsilon * estimate(maze, index);
+    }
+
+    // Expands until no open cell can lead to a cheaper goal at this
+    // inflation. Returns false when the deadline or the query limits cut
+    // the iteration short.
+    bool improvePath(const Maze& maze, double epsilon, const Deadline* deadline, PathfindingResult& result,
+                     bool visualize, VisualizationCallback callback) {
+        size_t expansions = 0;
+        while (!open_.empty() && state_.cost(goalIndex_) > open_.topKey()) {
+            if (limitReached(result.nodesExplored)) return false;
+            if (deadline && timeBudgetMs_ > 0 && ++expansions % CLOCK_INTERVAL == 0 &&
+                std::chrono::high_resolution_clock::now() >= *deadline) {
+                return false;
+            }
+
+            const int current = open_.pop();
+            state_.close(current);
+            closedList_.push_back(current);
+            result.nodesExplored++;
+            traceExpansion(current);
+            noteExpansion(maze, current);
+            if (visualize) {
+                visualizeStep(maze.pointAt(current), reconstructPath(state_, maze, current), visualize, callback);
+            }
+
+            const Cost currentG = state_.cost(current);
+            unsigned mask = maze.getNeighborMask(current);
+            for (; mask != 0; mask &= mask - 1) {
+                const int d = countTrailingZeros(static_cast<std::uint32_t>(mask));
+                const int neighbor = current + offsets_[d];
+                const Cost g = currentG + OctileCost::step(EightNeighborhood::DX[d], EightNeighborhood::DY[d]);
+                if (g >= state_.cost(neighbor)) continue;
+                const bool wasClosed = state_.closed(neighbor);
+                state_.open(neighbor, g, current);
+                traceParent(neighbor, current);
+                if (wasClosed) {
+                    incons_.push_back(neighbor);
+                } else {
+                    open_.pushOrDecrease(neighbor, key(maze, neighbor, epsilon));
+                }
+            }
+        }
+        return true;
+    }
+};
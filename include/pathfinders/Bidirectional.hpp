@@ -0,0 +1,234 @@
+#pragma once
+
+#include "Pathfinder.hpp"
+#include "OpenList.hpp"
+#include "CostModel.hpp"
+#include "Heuristic.hpp"
+#include "Neighborhood.hpp"
+#include "Bits.hpp"
+#include <bits/stdc++.h>
+
+// Searches grown from both endpoints at once until they meet. Moves are
+// symmetric, so the backward search expands the same neighbour masks as the
+// forward one. Each side keeps its own SearchState; a cell reached by both
+// joins the two parent chains into a path. Traces get the expansions of
+// both sides but only the forward side's parents, which share one tree.
+
+// Start to meeting cell along the forward parents, then on to the goal
+// along the backward ones
+template<typename Cost>
+std::vector<Maze::Point> joinBidirectionalPaths(const Maze& maze, const BasicSearchState<Cost>& forward,
+                                   const BasicSearchState<Cost>& backward, int meeting) {
+    std::vector<Maze::Point> path;
+    for (int cell = meeting; cell != BasicSearchState<Cost>::NO_PARENT; cell = forward.parent(cell)) {
+        path.push_back(maze.pointAt(cell));
+    }
+    std::reverse(path.begin(), path.end());
+    for (int cell = backward.parent(meeting); cell != BasicSearchState<Cost>::NO_PARENT; cell = backward.parent(cell)) {
+        path.push_back(maze.pointAt(cell));
+    }
+    return path;
+}
+
+// Breadth-first search over 4-directional moves, one whole level at a time
+// on the side with the smaller frontier. Once a level reaches cells the
+// other side has seen, the cheapest of those meetings is a shortest path:
+// any shorter one would have met a level earlier.
+class BidirectionalBFS : public Pathfinder {
+public:
+    std::string getName() const override {
+        return "Bidirectional BFS";
+    }
+
+protected:
+    PathfindingResult search(const Maze& maze, const Maze::Point& start, const Maze::Point& goal,
+                             bool visualize, VisualizationCallback callback) override {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        PathfindingResult result;
+
+        if (!hasValidEndpoints(maze, start, goal) || !mayBeReachable(maze, start, goal)) return result;
+
+        const size_t cellCount = static_cast<size_t>(maze.getWidth()) * maze.getHeight();
+        for (int d = 0; d < FourNeighborhood::COUNT; ++d) {
+            offsets_[d] = FourNeighborhood::DY[d] * maze.getWidth() + FourNeighborhood::DX[d];
+        }
+        Side* sides[2] = {&forward_, &backward_};
+        const int roots[2] = {maze.index(start.x, start.y), maze.index(goal.x, goal.y)};
+        for (int s = 0; s < 2; ++s) {
+            sides[s]->state.reset(cellCount);
+            sides[s]->state.open(roots[s], 0, BasicSearchState<int>::NO_PARENT);
+            sides[s]->frontier.assign(1, roots[s]);
+        }
+
+        int meeting = roots[0] == roots[1] ? roots[0] : -1;
+        int best = meeting >= 0 ? 0 : std::numeric_limits<int>::max();
+        while (meeting < 0 && !forward_.frontier.empty() && !backward_.frontier.empty() &&
+               !limitReached(result.nodesExplored)) {
+            const bool forwardTurn = forward_.frontier.size() <= backward_.frontier.size();
+            Side& side = forwardTurn ? forward_ : backward_;
+            const Side& other = forwardTurn ? backward_ : forward_;
+
+            side.next.clear();
+            for (int current : side.frontier) {
+                if (limitReached(result.nodesExplored)) break;
+                result.nodesExplored++;
+                traceExpansion(current);
+                if (forwardTurn) noteExpansion(maze, current);
+                if (visualize) {
+                    visualizeStep(maze.pointAt(current), {}, visualize, callback);
+                }
+
+                const int cost = side.state.cost(current) + 1;
+                unsigned mask = maze.getNeighborMask(current) & FourNeighborhood::MASK;
+                for (; mask != 0; mask &= mask - 1) {
+                    const int neighbor = current + offsets_[countTrailingZeros(static_cast<std::uint32_t>(mask))];
+                    if (side.state.visited(neighbor)) continue;
+                    side.state.open(neighbor, cost, current);
+                    if (forwardTurn) traceParent(neighbor, current);
+                    side.next.push_back(neighbor);
+                    if (other.state.visited(neighbor) && cost + other.state.cost(neighbor) < best) {
+                        best = cost + other.state.cost(neighbor);
+                        meeting = neighbor;
+                    }
+                }
+            }
+            side.frontier.swap(side.next);
+        }
+
+        if (limitStopped()) {
+            result.path = partialPath(forward_.state, maze);
+        } else if (meeting >= 0) {
+            result.path = joinBidirectionalPaths(maze, forward_.state, backward_.state, meeting);
+        }
+        result.pathLength = result.path.size();
+
+        // Calculate execution time
+        auto end_time = std::chrono::high_resolution_clock::now();
+        result.executionTime = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+
+        // Get memory usage
+        result.memoryUsage = getCurrentMemoryUsage() + forward_.state.memoryUsage() + backward_.state.memoryUsage();
+
+        return result;
+    }
+
+private:
+    struct Side {
+        BasicSearchState<int> state;
+        std::vector<int> frontier;
+        std::vector<int> next;
+    };
+
+    Side forward_;
+    Side backward_;
+    int offsets_[FourNeighborhood::COUNT] = {};
+};
+
+// A* from both ends in integer octile costs, each side estimating the
+// distance to the other side's root (front-to-end). The side with the
+// smaller open list expands next. mu, the cheapest start-to-goal cost seen
+// through a cell reached by both sides, is optimal once it is no more than
+// the larger of the two smallest f values: every path not yet seen still
+// runs through an open cell of each side, so it costs at least that much.
+class BidirectionalAStar : public Pathfinder {
+public:
+    std::string getName() const override {
+        return "Bidirectional A* (octile, integer)";
+    }
+
+protected:
+    PathfindingResult search(const Maze& maze, const Maze::Point& start, const Maze::Point& goal,
+                             bool visualize, VisualizationCallback callback) override {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        PathfindingResult result;
+
+        if (!hasValidEndpoints(maze, start, goal) || !mayBeReachable(maze, start, goal)) return result;
+
+        const size_t cellCount = static_cast<size_t>(maze.getWidth()) * maze.getHeight();
+        for (int d = 0; d < EightNeighborhood::COUNT; ++d) {
+            offsets_[d] = EightNeighborhood::DY[d] * maze.getWidth() + EightNeighborhood::DX[d];
+        }
+        Side* sides[2] = {&forward_, &backward_};
+        const Maze::Point roots[2] = {start, goal};
+        for (int s = 0; s < 2; ++s) {
+            const int root = maze.index(roots[s].x, roots[s].y);
+            sides[s]->target = roots[1 - s];
+            sides[s]->state.reset(cellCount);
+            sides[s]->open.reset(cellCount);
+            sides[s]->state.open(root, 0, BasicSearchState<Cost>::NO_PARENT);
+            sides[s]->open.push(root, estimate(roots[s], sides[s]->target));
+        }
+
+        const int startIndex = maze.index(start.x, start.y);
+        int meeting = startIndex == maze.index(goal.x, goal.y) ? startIndex : -1;
+        Cost mu = meeting >= 0 ? 0 : std::numeric_limits<Cost>::max();
+        while (!forward_.open.empty() && !backward_.open.empty()) {
+            if (mu <= std::max(forward_.open.topKey(), backward_.open.topKey())) break;
+            if (limitReached(result.nodesExplored)) break;
+
+            const bool forwardTurn = forward_.open.size() <= backward_.open.size();
+            Side& side = forwardTurn ? forward_ : backward_;
+            const Side& other = forwardTurn ? backward_ : forward_;
+
+            const int current = side.open.pop();
+            side.state.close(current);
+            result.nodesExplored++;
+            traceExpansion(current);
+            if (forwardTurn) noteExpansion(maze, current);
+            if (visualize) {
+                visualizeStep(maze.pointAt(current), {}, visualize, callback);
+            }
+
+            const Cost currentG = side.state.cost(current);
+            unsigned mask = maze.getNeighborMask(current);
+            for (; mask != 0; mask &= mask - 1) {
+                const int d = countTrailingZeros(static_cast<std::uint32_t>(mask));
+                const int neighbor = current + offsets_[d];
+                if (side.state.closed(neighbor)) continue;
+                const Cost g = currentG + OctileCost::step(EightNeighborhood::DX[d], EightNeighborhood::DY[d]);
+                if (g >= side.state.cost(neighbor)) continue;
+                side.state.open(neighbor, g, current);
+                if (forwardTurn) traceParent(neighbor, current);
+                side.open.pushOrDecrease(neighbor, g + estimate(maze.pointAt(neighbor), side.target));
+                if (other.state.visited(neighbor) && g + other.state.cost(neighbor) < mu) {
+                    mu = g + other.state.cost(neighbor);
+                    meeting = neighbor;
+                }
+            }
+        }
+
+        if (limitStopped()) {
+            result.path = partialPath(forward_.state, maze);
+        } else if (meeting >= 0) {
+            result.path = joinBidirectionalPaths(maze, forward_.state, backward_.state, meeting);
+        }
+        result.pathLength = result.path.size();
+
+        // Calculate execution time
+        auto end_time = std::chrono::high_resolution_clock::now();
+        result.executionTime = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+
+        // Get memory usage
+        result.memoryUsage = getCurrentMemoryUsage() + forward_.state.memoryUsage() + backward_.state.memoryUsage() +
+                             forward_.open.memoryUsage() + backward_.open.memoryUsage();
+
+        return result;
+    }
+
+private:
+    using Cost = OctileCost::Cost;
+
+    struct Side {
+        BasicSearchState<Cost> state;
+        QuadHeap<Cost> open;  // keyed by f
+        Maze::Point target;
+    };
+
+    Side forward_;
+    Side backward_;
+    int offsets_[EightNeighborhood::COUNT] = {};
+
+    static Cost estimate(const Maze::Point& from, const Maze::Point& to) {
+        return OctileHeuristic::estimate<Cost>(std::abs(from.x - to.x), std::abs(from.y - to.y));
+    }
+};
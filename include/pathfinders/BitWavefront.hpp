@@ -0,0 +1,256 @@
+#pragma once
+
+#include "Pathfinder.hpp"
+#include "Neighborhood.hpp"
+#include "Bits.hpp"
+#include <bits/stdc++.h>
+
+// Breadth-first search over 4-directional moves run as a bit-parallel
+// wavefront. Each BFS layer is one dilation of the previous layer's bitboard
+// (shifted left and right within a row, copied from the rows above and
+// below) masked with the walkable bits of Maze::getRowBits() and the cells
+// not reached yet, so 64 cells advance per word operation. The row loops
+// are plain word arithmetic the compiler can vectorise.
+//
+// Only words near the last layer are touched: every row keeps the span of
+// words its frontier occupies, and the next layer looks one word beyond the
+// spans of the row and its two neighbours.
+//
+// Instead of a distance per cell, two bit planes hold the layer number
+// modulo 3. Neighbouring cells differ by at most one layer, so walking back
+// from the goal, the neighbour one layer closer is the reached one whose
+// residue is one lower.
+class BitWavefront : public Pathfinder {
+protected:
+    PathfindingResult search(const Maze& maze, const Maze::Point& start, const Maze::Point& goal,
+                             bool visualize, VisualizationCallback callback) override {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        PathfindingResult result;
+
+        if (!hasValidEndpoints(maze, start, goal) || !mayBeReachable(maze, start, goal)) return result;
+
+        reset(maze);
+
+        setBit(reached_, start.x, start.y);
+        setBit(frontier_, start.x, start.y);
+        const int startWord = (Maze::BITMAP_OFFSET + start.x) >> 6;
+        frontierSpans_[start.y + 1] = Span{startWord, startWord};
+        frontierRows_ = Span{start.y, start.y};
+        result.nodesExplored = 1;
+
+        int layer = 0;
+        bool found = start == goal;
+        while (!found && !frontierRows_.empty() && !limitReached(result.nodesExplored)) {
+            ++layer;
+            result.nodesExplored += expand(maze, layer);
+            found = testBit(reached_, goal.x, goal.y);
+
+            if (visualize || getTrace()) {
+                reportFrontier(maze, visualize, callback);
+            }
+        }
+
+        if (found) {
+            result.path = walkBack(maze, goal, layer);
+        } else if (limitStopped()) {
+            result.path = walkBack(maze, closestFrontierCell(goal), layer);
+        }
+        result.pathLength = result.path.size();
+
+        // Calculate execution time
+        auto end_time = std::chrono::high_resolution_clock::now();
+        result.executionTime = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+
+        // Get memory usage
+        result.memoryUsage = getCurrentMemoryUsage() +
+                             (reached_.capacity() + residueLow_.capacity() + residueHigh_.capacity() +
+                              frontier_.capacity() + next_.capacity()) * sizeof(std::uint64_t) +
+                             (frontierSpans_.capacity() + nextSpans_.capacity()) * sizeof(Span);
+
+        return result;
+    }
+
+public:
+    std::string getName() const override {
+        return "Bitboard BFS (wavefront)";
+    }
+
+private:
+    // Inclusive range of words within a row, or of rows
+    struct Span {
+        int first = 1;
+        int last = 0;
+        bool empty() const { return last < first; }
+    };
+
+    int width_ = 0;
+    int height_ = 0;
+    size_t words_ = 0;
+
+    // Bitboards of height_ + 2 rows (a blank row above and below) of
+    // words_ words, laid out like Maze::getRowBits()
+    std::vector<std::uint64_t> reached_;
+    std::vector<std::uint64_t> residueLow_;   // layer % 3, bit 0
+    std::vector<std::uint64_t> residueHigh_;  // layer % 3, bit 1
+    std::vector<std::uint64_t> frontier_;
+    std::vector<std::uint64_t> next_;
+    std::vector<Span> frontierSpans_;  // per bitboard row
+    std::vector<Span> nextSpans_;
+    Span frontierRows_;
+    Span nextRows_;
+
+    void reset(const Maze& maze) {
+        width_ = maze.getWidth();
+        height_ = maze.getHeight();
+        words_ = maze.getRowWords();
+        const size_t size = words_ * (height_ + 2);
+        reached_.assign(size, 0);
+        residueLow_.assign(size, 0);
+        residueHigh_.assign(size, 0);
+        frontier_.assign(size, 0);
+        next_.assign(size, 0);
+        frontierSpans_.assign(height_ + 2, Span());
+        nextSpans_.assign(height_ + 2, Span());
+        frontierRows_ = Span();
+        nextRows_ = Span();
+    }
+
+    std::uint64_t* row(std::vector<std::uint64_t>& board, int y) {
+        return board.data() + static_cast<size_t>(y + 1) * words_;
+    }
+
+    void setBit(std::vector<std::uint64_t>& board, int x, int y) {
+        const int bit = Maze::BITMAP_OFFSET + x;
+        row(board, y)[bit >> 6] |= std::uint64_t(1) << (bit & 63);
+    }
+
+    bool testBit(const std::vector<std::uint64_t>& board, int x, int y) const {
+        const int bit = Maze::BITMAP_OFFSET + x;
+        return (board[static_cast<size_t>(y + 1) * words_ + (bit >> 6)] >> (bit & 63)) & 1;
+    }
+
+    // Grows the frontier by one layer into next_, then swaps the two.
+    // Returns the number of cells reached.
+    size_t expand(const Maze& maze, int layer) {
+        // next_ still holds the layer before last
+        for (int y = nextRows_.first; y <= nextRows_.last; ++y) {
+            Span& span = nextSpans_[y + 1];
+            if (span.empty()) continue;
+            std::fill(row(next_, y) + span.first, row(next_, y) + span.last + 1, 0);
+            span = Span();
+        }
+        nextRows_ = Span{height_, -1};
+
+        const int residue = layer % 3;
+        const int lastWord = static_cast<int>(words_) - 2;
+        size_t reachedCount = 0;
+        const int y0 = std::max(frontierRows_.first - 1, 0);
+        const int y1 = std::min(frontierRows_.last + 1, height_ - 1);
+        for (int y = y0; y <= y1; ++y) {
+            // Words the dilation can reach: the frontier spans of this row
+            // and its neighbours, one word wider
+            int first = lastWord + 1;
+            int last = 0;
+            for (int dy = -1; dy <= 1; ++dy) {
+                const Span& span = frontierSpans_[y + dy + 1];
+                if (span.empty()) continue;
+                first = std::min(first, span.first - 1);
+                last = std::max(last, span.last + 1);
+            }
+            first = std::max(first, 1);
+            last = std::min(last, lastWord);
+            if (last < first) continue;
+
+            const std::uint64_t* up = row(frontier_, y - 1);
+            const std::uint64_t* middle = row(frontier_, y);
+            const std::uint64_t* down = row(frontier_, y + 1);
+            const std::uint64_t* walkable = maze.getRowBits(y);
+            std::uint64_t* seen = row(reached_, y);
+            std::uint64_t* out = row(next_, y);
+            std::uint64_t* low = row(residueLow_, y);
+            std::uint64_t* high = row(residueHigh_, y);
+            Span& span = nextSpans_[y + 1];
+            for (int w = first; w <= last; ++w) {
+                const std::uint64_t f = middle[w];
+                const std::uint64_t grown = f | (f << 1) | (middle[w - 1] >> 63) |
+                                            (f >> 1) | (middle[w + 1] << 63) | up[w] | down[w];
+                const std::uint64_t bits = grown & walkable[w] & ~seen[w];
+                out[w] = bits;
+                if (bits == 0) continue;
+                seen[w] |= bits;
+                if (residue == 1) low[w] |= bits;
+                if (residue == 2) high[w] |= bits;
+                reachedCount += popCount(bits);
+                if (span.empty()) span.first = w;
+                span.last = w;
+            }
+            if (!span.empty()) {
+                nextRows_.first = std::min(nextRows_.first, y);
+                nextRows_.last = std::max(nextRows_.last, y);
+            }
+        }
+
+        frontier_.swap(next_);
+        frontierSpans_.swap(nextSpans_);
+        std::swap(frontierRows_, nextRows_);
+        return reachedCount;
+    }
+
+    int residueAt(int x, int y) const {
+        return static_cast<int>(testBit(residueLow_, x, y)) | (static_cast<int>(testBit(residueHigh_, x, y)) << 1);
+    }
+
+    std::vector<Maze::Point> walkBack(const Maze& maze, Maze::Point current, int layer) const {
+        std::vector<Maze::Point> path;
+        path.push_back(current);
+        for (; layer > 0; --layer) {
+            const int wanted = (layer - 1) % 3;
+            for (int d = 0; d < FourNeighborhood::COUNT; ++d) {
+                const int x = current.x + FourNeighborhood::DX[d];
+                const int y = current.y + FourNeighborhood::DY[d];
+                if (maze.isValidCell(x, y) && testBit(reached_, x, y) && residueAt(x, y) == wanted) {
+                    current = Maze::Point(x, y);
+                    break;
+                }
+            }
+            path.push_back(current);
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+
+    // Frontier cell nearest the goal, where a stopped search got furthest
+    Maze::Point closestFrontierCell(const Maze::Point& goal) {
+        Maze::Point best = goal;
+        int bestDistance = std::numeric_limits<int>::max();
+        for (int y = frontierRows_.first; y <= frontierRows_.last; ++y) {
+            const Span& span = frontierSpans_[y + 1];
+            const std::uint64_t* bits = row(frontier_, y);
+            for (int w = span.first; w <= span.last; ++w) {
+                for (std::uint64_t word = bits[w]; word != 0; word &= word - 1) {
+                    const int x = w * 64 + countTrailingZeros(word) - Maze::BITMAP_OFFSET;
+                    const int distance = std::abs(x - goal.x) + std::abs(y - goal.y);
+                    if (distance < bestDistance) {
+                        bestDistance = distance;
+                        best = Maze::Point(x, y);
+                    }
+                }
+            }
+        }
+        return best;
+    }
+
+    void reportFrontier(const Maze& maze, bool visualize, VisualizationCallback callback) {
+        for (int y = frontierRows_.first; y <= frontierRows_.last; ++y) {
+            const Span& span = frontierSpans_[y + 1];
+            const std::uint64_t* bits = row(frontier_, y);
+            for (int w = span.first; w <= span.last; ++w) {
+                for (std::uint64_t word = bits[w]; word != 0; word &= word - 1) {
+                    const int x = w * 64 + countTrailingZeros(word) - Maze::BITMAP_OFFSET;
+                    traceExpansion(maze.index(x, y));
+                    visualizeStep(Maze::Point(x, y), {}, visualize, callback);
+                }
+            }
+        }
+    }
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+
+// Bit-scan helpers for the mask and bitmap based inner loops. The argument
+// must be non-zero.
+inline int countTrailingZeros(std::uint32_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(bits);
+#else
+    int n = 0;
+    while (!(bits & 1u)) { bits >>= 1; ++n; }
+    return n;
+#endif
+}
+
+inline int countTrailingZeros(std::uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(bits);
+#else
+    int n = 0;
+    while (!(bits & 1u)) { bits >>= 1; ++n; }
+    return n;
+#endif
+}
+
+inline int countLeadingZeros(std::uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(bits);
+#else
+    int n = 0;
+    while (!(bits & (std::uint64_t(1) << 63))) { bits <<= 1; ++n; }
+    return n;
+#endif
+}
+
+inline int popCount(std::uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(bits);
+#else
+    int n = 0;
+    for (; bits != 0; bits &= bits - 1) ++n;
+    return n;
+#endif
+}
+
+// 64 bits of a packed bit line starting at bit position `bit`
+inline std::uint64_t readBits(const std::uint64_t* line, int bit) {
+    const int word = bit >> 6;
+    const int shift = bit & 63;
+    std::uint64_t bits = line[word] >> shift;
+    if (shift != 0) bits |= line[word + 1] << (64 - shift);
+    return bits;
+}
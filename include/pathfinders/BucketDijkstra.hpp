@@ -0,0 +1,22 @@
+#pragma once
+
+#include "SearchCore.hpp"
+#include <bits/stdc++.h>
+
+// Dijkstra's algorithm over small integer step costs. With bounded costs the
+// open list can be a bucket structure instead of a comparison heap, which
+// removes the log factor from every push and pop.
+template<typename OpenList, typename CostModel>
+using IntegerDijkstra = BestFirstSearch<EightNeighborhood, ZeroHeuristic, CostModel, OpenList>;
+
+// Same uniform step cost as Dijkstra, on Dial's circular bucket queue
+class DialDijkstra : public IntegerDijkstra<BucketQueue<int, UnitCost::MAX_STEP>, UnitCost> {
+public:
+    DialDijkstra() : BestFirstSearch("Dijkstra (Dial buckets)") {}
+};
+
+// Octile step costs (10/14) on a radix heap
+class RadixDijkstra : public IntegerDijkstra<RadixHeap<int>, OctileCost> {
+public:
+    RadixDijkstra() : BestFirstSearch("Dijkstra (octile, radix heap)") {}
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cmath>
+
+// Step cost models for grid searches. Each model names its cost type and the
+// largest single-step cost, which bounds the key spread of bucket queues.
+
+// Every move costs 1, diagonal or not
+struct UnitCost {
+    using Cost = int;
+    static constexpr Cost MAX_STEP = 1;
+    static Cost step(int /*dx*/, int /*dy*/) { return 1; }
+};
+
+// Octile distances scaled to integers: 10 per straight move, 14 per diagonal
+struct OctileCost {
+    using Cost = int;
+    static constexpr Cost STRAIGHT = 10;
+    static constexpr Cost DIAGONAL = 14;
+    static constexpr Cost MAX_STEP = DIAGONAL;
+    static Cost step(int dx, int dy) { return (dx != 0 && dy != 0) ? DIAGONAL : STRAIGHT; }
+};
+
+// True Euclidean step lengths: 1 straight, sqrt(2) diagonal
+struct EuclideanCost {
+    using Cost = double;
+    static constexpr Cost STRAIGHT = 1.0;
+    static constexpr Cost DIAGONAL = 1.4142135623730951;
+    static constexpr Cost MAX_STEP = DIAGONAL;
+    static Cost step(int dx, int dy) { return (dx != 0 && dy != 0) ? DIAGONAL : STRAIGHT; }
+};
+
+// Cost of the shortest obstacle-free 8-connected route over |dx|, |dy| in the
+// units of a model with STRAIGHT / DIAGONAL costs
+template<typename CostModel>
+typename CostModel::Cost octileDistance(int dx, int dy) {
+    const int diagonal = dx < dy ? dx : dy;
+    const int straight = (dx < dy ? dy : dx) - diagonal;
+    return CostModel::STRAIGHT * straight + CostModel::DIAGONAL * diagonal;
+}
+
+// Path cost is ignored entirely, as in greedy best-first search
+struct ZeroCost {
+    using Cost = double;
+    static constexpr Cost MAX_STEP = 0.0;
+    static Cost step(int /*dx*/, int /*dy*/) { return 0.0; }
+};
@@ -0,0 +1,249 @@
+#pragma once
+
+#include "Pathfinder.hpp"
+#include "OpenList.hpp"
+#include "CostModel.hpp"
+#include "Heuristic.hpp"
+#include "Neighborhood.hpp"
+#include "Bits.hpp"
+#include <bits/stdc++.h>
+
+// D* Lite (Koenig & Likhachev, "D* Lite", AAAI 2002), in integer octile
+// costs. The search runs backwards from the goal and keeps its g / rhs
+// values between queries, so a planner that discovers obstacles as it moves
+// only repairs the part of the tree an edit invalidated.
+//
+// Edits are picked up from Maze::getWalkabilityChanges() on the next query:
+// every cell whose edges may have changed (the edited area plus a ring of
+// one) gets its rhs recomputed and re-enters the open list if it became
+// inconsistent. A moved start only raises the key modifier km; a new goal,
+// a resize or a change history the maze no longer remembers starts over.
+class DStarLite : public Pathfinder {
+protected:
+    PathfindingResult search(const Maze& maze, const Maze::Point& start, const Maze::Point& goal,
+                             bool visualize, VisualizationCallback callback) override {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        PathfindingResult result;
+
+        lastRunWasRepair_ = false;
+        if (!hasValidEndpoints(maze, start, goal) || !mayBeReachable(maze, start, goal)) return result;
+
+        const int startIndex = maze.index(start.x, start.y);
+        const int goalIndex = maze.index(goal.x, goal.y);
+
+        Maze::Rect changed;
+        lastRunWasRepair_ = goalIndex == goal_ && maze.getWidth() == width_ && maze.getHeight() == height_ &&
+                            maze.getWalkabilityChanges(stamp_, changed) &&
+                            static_cast<size_t>(changed.width) * changed.height * MAX_REPAIR_FRACTION <= g_.size();
+        if (lastRunWasRepair_) {
+            if (startIndex != start_) {
+                km_ += heuristic(startPoint_, start);
+                start_ = startIndex;
+                startPoint_ = start;
+            }
+            repair(maze, changed);
+        } else {
+            initialize(maze, startIndex, goalIndex);
+        }
+        stamp_ = maze.getWalkabilityStamp();
+
+        // A search stopped by the query limits leaves a valid state that the
+        // next query simply carries on from; there is no partial path, as
+        // the search runs from the goal
+        computeShortestPath(maze, visualize, callback, result.nodesExplored);
+        if (!limitStopped()) {
+            result.path = extractPath(maze);
+        }
+        result.pathLength = result.path.size();
+
+        // Calculate execution time
+        auto end_time = std::chrono::high_resolution_clock::now();
+        result.executionTime = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+
+        // Get memory usage
+        result.memoryUsage = getCurrentMemoryUsage() + g_.capacity() * sizeof(Cost) +
+                             rhs_.capacity() * sizeof(Cost) + open_.memoryUsage();
+
+        return result;
+    }
+
+public:
+    std::string getName() const override {
+        return "D* Lite (incremental)";
+    }
+
+    // Whether the last query repaired the previous search instead of
+    // starting over
+    bool lastRunWasRepair() const { return lastRunWasRepair_; }
+
+private:
+    using Cost = OctileCost::Cost;
+    static constexpr Cost INF = std::numeric_limits<Cost>::max() / 2;
+
+    // Repairs covering more than 1 / MAX_REPAIR_FRACTION of the grid start over
+    static constexpr size_t MAX_REPAIR_FRACTION = 4;
+
+    int width_ = 0;
+    int height_ = 0;
+    std::uint64_t stamp_ = 0;
+    int start_ = -1;
+    int goal_ = -1;
+    Maze::Point startPoint_;
+    Cost km_ = 0;
+    bool lastRunWasRepair_ = false;
+    int offsets_[Maze::DIRECTION_COUNT] = {};
+
+    std::vector<Cost> g_;
+    std::vector<Cost> rhs_;
+    QuadHeap<std::uint64_t> open_;
+
+    static Cost heuristic(const Maze::Point& a, const Maze::Point& b) {
+        return OctileHeuristic::estimate<Cost>(std::abs(a.x - b.x), std::abs(a.y - b.y));
+    }
+
+    // [min(g, rhs) + h + km, min(g, rhs)] compared lexicographically
+    std::uint64_t key(const Maze& maze, int index) const {
+        const Cost best = std::min(g_[index], rhs_[index]);
+        const Cost primary = best + heuristic(startPoint_, maze.pointAt(index)) + km_;
+        return (static_cast<std::uint64_t>(primary) << 32) | static_cast<std::uint32_t>(best);
+    }
+
+    void initialize(const Maze& maze, int startIndex, int goalIndex) {
+        width_ = maze.getWidth();
+        height_ = maze.getHeight();
+        for (int d = 0; d < Maze::DIRECTION_COUNT; ++d) {
+            offsets_[d] = EightNeighborhood::DY[d] * width_ + EightNeighborhood::DX[d];
+        }
+
+        const size_t cellCount = static_cast<size_t>(width_) * height_;
+        g_.assign(cellCount, INF);
+        rhs_.assign(cellCount, INF);
+        open_.reset(cellCount);
+        km_ = 0;
+        start_ = startIndex;
+        startPoint_ = maze.pointAt(startIndex);
+        goal_ = goalIndex;
+
+        rhs_[goal_] = 0;
+        open_.push(goal_, key(maze, goal_));
+    }
+
+    // Moves are symmetric: both cells walkable and next to each other
+    template<typename Visit>
+    void forEachNeighbor(const Maze& maze, int index, Visit&& visit) const {
+        const Maze::Point p = maze.pointAt(index);
+        if (!maze.isPassable(p.x, p.y)) return;
+        unsigned mask = maze.getNeighborMask(index);
+        for (; mask != 0; mask &= mask - 1) {
+            const int d = countTrailingZeros(static_cast<std::uint32_t>(mask));
+            visit(index + offsets_[d], OctileCost::step(EightNeighborhood::DX[d], EightNeighborhood::DY[d]));
+        }
+    }
+
+    Cost bestSuccessor(const Maze& maze, int index) const {
+        Cost best = INF;
+        forEachNeighbor(maze, index, [&](int neighbor, Cost step) {
+            best = std::min(best, step + g_[neighbor]);
+        });
+        return std::min(best, INF);
+    }
+
+    void updateVertex(const Maze& maze, int index) {
+        if (g_[index] != rhs_[index]) {
+            if (open_.contains(index)) {
+                open_.update(index, key(maze, index));
+            } else {
+                open_.push(index, key(maze, index));
+            }
+        } else if (open_.contains(index)) {
+            open_.erase(index);
+        }
+    }
+
+    void repair(const Maze& maze, const Maze::Rect& changed) {
+        if (changed.empty()) return;
+        const int x0 = std::max(changed.x - 1, 0);
+        const int y0 = std::max(changed.y - 1, 0);
+        const int x1 = std::min(changed.x + changed.width + 1, width_);
+        const int y1 = std::min(changed.y + changed.height + 1, height_);
+        for (int y = y0; y < y1; ++y) {
+            for (int x = x0; x < x1; ++x) {
+                const int index = maze.index(x, y);
+                if (index == goal_) continue;
+                rhs_[index] = bestSuccessor(maze, index);
+                updateVertex(maze, index);
+            }
+        }
+    }
+
+    void computeShortestPath(const Maze& maze, bool visualize, VisualizationCallback callback,
+                             size_t& nodesExplored) {
+        while (!open_.empty()) {
+            const std::uint64_t topKey = open_.topKey();
+            if (!(topKey < key(maze, start_)) && rhs_[start_] == g_[start_]) break;
+
+            const int current = open_.top();
+            const std::uint64_t newKey = key(maze, current);
+            if (topKey < newKey) {
+                // Stale key from before the start moved
+                open_.update(current, newKey);
+                continue;
+            }
+
+            if (limitReached(nodesExplored)) break;
+            ++nodesExplored;
+            traceExpansion(current);
+            if (visualize) {
+                visualizeStep(maze.pointAt(current), {}, visualize, callback);
+            }
+
+            if (g_[current] > rhs_[current]) {
+                // Overconsistent: settle it and offer it to the neighbours
+                g_[current] = rhs_[current];
+                open_.pop();
+                forEachNeighbor(maze, current, [&](int neighbor, Cost step) {
+                    if (neighbor != goal_ && step + g_[current] < rhs_[neighbor]) {
+                        rhs_[neighbor] = step + g_[current];
+                        updateVertex(maze, neighbor);
+                    }
+                });
+            } else {
+                // Underconsistent: forget it, and every neighbour that
+                // relied on it looks for another way
+                const Cost oldG = g_[current];
+                g_[current] = INF;
+                updateVertex(maze, current);
+                forEachNeighbor(maze, current, [&](int neighbor, Cost step) {
+                    if (neighbor != goal_ && rhs_[neighbor] == step + oldG) {
+                        rhs_[neighbor] = bestSuccessor(maze, neighbor);
+                    }
+                    updateVertex(maze, neighbor);
+                });
+            }
+        }
+    }
+
+    // Walk downhill in g from the start
+    std::vector<Maze::Point> extractPath(const Maze& maze) const {
+        std::vector<Maze::Point> path;
+        if (g_[start_] >= INF) return path;
+
+        int current = start_;
+        path.push_back(maze.pointAt(current));
+        while (current != goal_ && path.size() <= g_.size()) {
+            int next = -1;
+            Cost best = INF;
+            forEachNeighbor(maze, current, [&](int neighbor, Cost step) {
+                if (step + g_[neighbor] < best) {
+                    best = step + g_[neighbor];
+                    next = neighbor;
+                }
+            });
+            if (next < 0) return {};
+            current = next;
+            path.push_back(maze.pointAt(current));
+        }
+        if (current != goal_) return {};
+        return path;
+    }
+};
@@ -0,0 +1,208 @@
+#pragma once
+
+#include "Pathfinder.hpp"
+#include "OpenList.hpp"
+#include "CostModel.hpp"
+#include "Neighborhood.hpp"
+#include "Bits.hpp"
+#include <bits/stdc++.h>
+
+// Direction field towards one goal: one byte per cell naming the neighbour
+// on a cheapest octile route to the goal, built by a single Dijkstra run
+// outwards from the goal (moves are symmetric, so the reverse search gives
+// forward routes). Any number of agents bound for that goal then move in
+// O(1) per step with a table lookup and no search of their own.
+//
+// The field is immutable once built and tied to the walkability stamp of
+// the maze it was built from, so it can be shared freely between threads.
+class FlowField {
+public:
+    // Asked with the cells settled so far whether to give up building
+    using StopCondition = std::function<bool(size_t settled)>;
+
+    // Direction bytes 0..7 follow Maze::DIRECTION_DX/DY; these two mark the
+    // goal itself and cells that cannot reach it (walls included)
+    static constexpr std::uint8_t AT_GOAL = Maze::DIRECTION_COUNT;
+    static constexpr std::uint8_t UNREACHABLE = Maze::DIRECTION_COUNT + 1;
+
+    // A field whose build was stopped is incomplete: cells it did not settle
+    // read as unreachable, and it must not be shared
+    FlowField(const Maze& maze, const Maze::Point& goal, const StopCondition& stop = nullptr)
+        : width_(maze.getWidth()), goal_(goal), stamp_(maze.getWalkabilityStamp()) {
+        for (int d = 0; d < Maze::DIRECTION_COUNT; ++d) {
+            offsets_[d] = Maze::DIRECTION_DY[d] * width_ + Maze::DIRECTION_DX[d];
+        }
+        offsets_[AT_GOAL] = 0;
+        offsets_[UNREACHABLE] = 0;
+
+        const size_t cellCount = static_cast<size_t>(width_) * maze.getHeight();
+        directions_.assign(cellCount, UNREACHABLE);
+        if (!maze.isWalkable(goal.x, goal.y)) return;
+
+        // Each cell remembers the direction back towards the neighbour that
+        // last lowered its cost
+        constexpr std::uint8_t OPPOSITE[Maze::DIRECTION_COUNT] = {2, 3, 0, 1, 7, 6, 5, 4};
+        std::vector<OctileCost::Cost> cost(cellCount, std::numeric_limits<OctileCost::Cost>::max());
+        BucketQueue<OctileCost::Cost, OctileCost::MAX_STEP> open;
+        open.reset(cellCount);
+        const int goalIndex = maze.index(goal.x, goal.y);
+        cost[goalIndex] = 0;
+        directions_[goalIndex] = AT_GOAL;
+        open.push(goalIndex, 0);
+        while (!open.empty()) {
+            if (stop && stop(settled_)) {
+                complete_ = false;
+                break;
+            }
+            const int current = open.pop();
+            ++settled_;
+            unsigned mask = maze.getNeighborMask(current);
+            for (; mask != 0; mask &= mask - 1) {
+                const int d = countTrailingZeros(static_cast<std::uint32_t>(mask));
+                const int neighbor = current + offsets_[d];
+                const OctileCost::Cost next = cost[current] + OctileCost::step(Maze::DIRECTION_DX[d], Maze::DIRECTION_DY[d]);
+                if (next < cost[neighbor]) {
+                    cost[neighbor] = next;
+                    directions_[neighbor] = OPPOSITE[d];
+                    open.pushOrDecrease(neighbor, next);
+                }
+            }
+        }
+
+        // Cells reached but not settled may still point the wrong way
+        if (!complete_) {
+            while (!open.empty()) directions_[open.pop()] = UNREACHABLE;
+        }
+    }
+
+    const Maze::Point& getGoal() const { return goal_; }
+    bool isComplete() const { return complete_; }
+    std::uint64_t getWalkabilityStamp() const { return stamp_; }
+
+    // Cells settled while building, the whole cost of the field
+    size_t getSettledCount() const { return settled_; }
+
+    std::uint8_t direction(int index) const { return directions_[index]; }
+    bool reaches(int index) const { return directions_[index] != UNREACHABLE; }
+
+    // One step towards the goal; the goal and unreachable cells stay put
+    int next(int index) const { return index + offsets_[directions_[index]]; }
+
+    // Moves every agent (a cell index) one step. The loop is a branch-free
+    // byte load and table lookup per agent, which compilers vectorise with
+    // gathers where the target has them.
+    void advance(std::vector<int>& agents) const {
+        const std::uint8_t* directions = directions_.data();
+        for (int& agent : agents) {
+            agent += offsets_[directions[agent]];
+        }
+    }
+
+    // Route from a start cell to the goal, empty when there is none
+    std::vector<Maze::Point> pathFrom(const Maze& maze, const Maze::Point& start) const {
+        std::vector<Maze::Point> path;
+        int current = maze.index(start.x, start.y);
+        if (!reaches(current)) return path;
+        path.push_back(start);
+        while (directions_[current] != AT_GOAL) {
+            current = next(current);
+            path.push_back(maze.pointAt(current));
+        }
+        return path;
+    }
+
+    size_t memoryUsage() const { return directions_.capacity(); }
+
+private:
+    int width_;
+    Maze::Point goal_;
+    std::uint64_t stamp_;
+    size_t settled_ = 0;
+    bool complete_ = true;
+    int offsets_[Maze::DIRECTION_COUNT + 2];
+    std::vector<std::uint8_t> directions_;  // row-major, one byte per cell
+};
+
+// Flow-field mode: queries are answered by following the field of their
+// goal. Fields of the most recently used goals are kept, so every agent
+// after the first bound for the same goal costs only its walk; the cache is
+// dropped as soon as the maze's walkability changes.
+class FlowFieldPathfinder : public Pathfinder {
+public:
+    explicit FlowFieldPathfinder(size_t capacity = 8) : capacity_(std::max<size_t>(capacity, 1)) {}
+
+    // Field for a goal of this maze, built on a miss. Shared so agents can
+    // keep following it while the cache moves on.
+    std::shared_ptr<const FlowField> getField(const Maze& maze, const Maze::Point& goal) {
+        return lookup(maze, goal, nullptr);
+    }
+
+    // Whether the last query found its goal's field already built
+    bool lastWasCacheHit() const { return lastWasHit_; }
+
+    std::string getName() const override {
+        return "Flow field (cached per goal)";
+    }
+
+protected:
+    PathfindingResult search(const Maze& maze, const Maze::Point& start, const Maze::Point& goal,
+                             bool visualize, VisualizationCallback callback) override {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        PathfindingResult result;
+
+        lastWasHit_ = false;
+        if (!hasValidEndpoints(maze, start, goal) || !mayBeReachable(maze, start, goal)) return result;
+
+        // A build cut short by the query limits answers only this query
+        std::shared_ptr<const FlowField> field =
+            lookup(maze, goal, [this](size_t settled) { return limitReached(settled); });
+        if (!lastWasHit_) result.nodesExplored = field->getSettledCount();
+        result.path = field->pathFrom(maze, start);
+        result.pathLength = result.path.size();
+
+        if (visualize || getTrace()) {
+            for (const Maze::Point& point : result.path) {
+                traceExpansion(maze.index(point.x, point.y));
+                visualizeStep(point, {}, visualize, callback);
+            }
+        }
+
+        // Calculate execution time
+        auto end_time = std::chrono::high_resolution_clock::now();
+        result.executionTime = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+
+        // Get memory usage
+        result.memoryUsage = getCurrentMemoryUsage();
+        for (const auto& cached : fields_) result.memoryUsage += cached->memoryUsage();
+
+        return result;
+    }
+
+private:
+    size_t capacity_;
+    std::uint64_t stamp_ = 0;
+    bool lastWasHit_ = false;
+    std::vector<std::shared_ptr<const FlowField>> fields_;  // most recently used first
+
+    std::shared_ptr<const FlowField> lookup(const Maze& maze, const Maze::Point& goal,
+                                            const FlowField::StopCondition& stop) {
+        if (maze.getWalkabilityStamp() != stamp_) {
+            fields_.clear();
+            stamp_ = maze.getWalkabilityStamp();
+        }
+
+        for (size_t i = 0; i < fields_.size(); ++i) {
+            if (fields_[i]->getGoal() != goal) continue;
+            std::rotate(fields_.begin(), fields_.begin() + i, fields_.begin() + i + 1);
+            lastWasHit_ = true;
+            return fields_.front();
+        }
+
+        lastWasHit_ = false;
+        auto field = std::make_shared<const FlowField>(maze, goal, stop);
+        if (!field->isComplete()) return field;
+        if (fields_.size() == capacity_) fields_.pop_back();
+        fields_.insert(fields_.begin(), std::move(field));
+        return fields_.front();
+    }
+};
@@ -0,0 +1,781 @@
+#pragma once
+
+#include "Pathfinder.hpp"
+#include "OpenList.hpp"
+#include "CostModel.hpp"
+#include "Heuristic.hpp"
+#include "Neighborhood.hpp"
+#include "Bits.hpp"
+#include <bits/stdc++.h>
+
+// Hierarchical path-finding A* (Botea, Müller & Schaeffer, "Near Optimal
+// Hierarchical Path-Finding", 2004), in integer octile costs.
+//
+// The grid is cut into square clusters. Wherever a path can cross from one
+// cluster into a neighbour, an entrance (a transition between two border
+// cells) is placed; inside every cluster the entrances are joined by edges
+// carrying their exact cost within the cluster. A query links the start and
+// goal into that abstract graph, searches it, and refines each abstract
+// edge with an A* confined to one cluster.
+//
+// Entrances keep the abstraction complete for 8-connected moves: straight
+// crossings are grouped into runs along the border (one transition in the
+// middle, or one at each end of a wide run), and a diagonal crossing
+// through a border or a cluster corner gets its own transition when no
+// straight crossing next to it already connects the same cells. Cells are
+// labelled with their connected component inside the cluster, and an
+// opening is dropped when a wider one close by along the same border joins
+// the same two components; this keeps noisy borders from flooding the
+// abstract graph at a small cost in path quality.
+//
+// The hierarchy follows the maze through Maze::getWalkabilityChanges():
+// after an edit only the clusters touching the changed area, plus
+// neighbours whose entrances moved, are rebuilt.
+class HPAStar : public Pathfinder {
+public:
+    // Cluster sizes are clamped to [1, MAX_CLUSTER_SIZE]
+    explicit HPAStar(int clusterSize = 32) : clusterSize_(std::clamp(clusterSize, 1, MAX_CLUSTER_SIZE)) {
+        while ((1 << slotShift_) < clusterSize_) ++slotShift_;
+    }
+
+    void prepare(const Maze& maze) override {
+        update(maze);
+    }
+
+    // The hierarchy is patched in place after edits, so it is copied rather
+    // than shared; the copy still saves building it again
+    bool sharePreprocessing(const Pathfinder& source) override {
+        const auto* other = dynamic_cast<const HPAStar*>(&source);
+        if (other == nullptr || other == this || other->clusterSize_ != clusterSize_) return false;
+        width_ = other->width_;
+        height_ = other->height_;
+        clustersX_ = other->clustersX_;
+        clustersY_ = other->clustersY_;
+        stamp_ = other->stamp_;
+        clusters_ = other->clusters_;
+        component_ = other->component_;
+        nodeBase_ = other->nodeBase_;
+        nodeCluster_ = other->nodeCluster_;
+        nodePoint_ = other->nodePoint_;
+        entranceSlot_.assign(size_t(1) << (2 * slotShift_), -1);
+        return true;
+    }
+
+protected:
+    PathfindingResult search(const Maze& maze, const Maze::Point& start, const Maze::Point& goal,
+                             bool visualize, VisualizationCallback callback) override {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        PathfindingResult result;
+
+        lastRebuildCount_ = 0;
+        if (!hasValidEndpoints(maze, start, goal) || !mayBeReachable(maze, start, goal)) return result;
+        update(maze);
+
+        const int startIndex = maze.index(start.x, start.y);
+        const int goalIndex = maze.index(goal.x, goal.y);
+        const int startCluster = clusterOf(start);
+        const int goalCluster = clusterOf(goal);
+
+        // Same cluster and connected inside it: no abstraction needed
+        result.path.push_back(start);
+        if (startCluster == goalCluster && component_[startIndex] == component_[goalIndex] &&
+            localSearch(maze, clusters_[startCluster].area, start, goal, &result.path, result.nodesExplored)) {
+            result.pathLength = result.path.size();
+        } else {
+            result.path.clear();
+        }
+
+        // Otherwise search the abstract graph and refine every edge into cells
+        std::vector<Maze::Point> abstractPath;
+        if (result.path.empty()) {
+            abstractPath = abstractSearch(maze, start, goal, visualize, callback, result.nodesExplored);
+        }
+        if (!abstractPath.empty()) {
+            result.path.push_back(start);
+            for (size_t i = 1; i < abstractPath.size(); ++i) {
+                const Maze::Point& a = abstractPath[i - 1];
+                const Maze::Point& b = abstractPath[i];
+                if (a == b) continue;  // start or goal on an entrance
+                if (std::abs(a.x - b.x) <= 1 && std::abs(a.y - b.y) <= 1) {
+                    result.path.push_back(b);
+                } else {
+                    localSearch(maze, clusters_[clusterOf(a)].area, a, b, &result.path, result.nodesExplored);
+                }
+            }
+            result.pathLength = result.path.size();
+        }
+
+        // Refinement cut short leaves gaps, so a stopped query has no path
+        if (limitStopped()) {
+            result.path.clear();
+            result.pathLength = 0;
+        }
+
+        // Calculate execution time
+        auto end_time = std::chrono::high_resolution_clock::now();
+        result.executionTime = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+
+        // Get memory usage
+        result.memoryUsage = getCurrentMemoryUsage() + memoryUsage();
+
+        return result;
+    }
+
+public:
+    std::string getName() const override {
+        return "HPA* (" + std::to_string(clusterSize_) + "x" + std::to_string(clusterSize_) + " clusters)";
+    }
+
+    // Clusters whose internal edges the last update recomputed
+    size_t getLastRebuildCount() const { return lastRebuildCount_; }
+
+    // Entrances in the abstract graph
+    size_t getEntranceCount() const {
+        return nodeBase_.empty() ? 0 : static_cast<size_t>(nodeBase_.back());
+    }
+
+private:
+    using Cost = OctileCost::Cost;
+    static constexpr Cost NO_COST = -1;
+    static constexpr int MAX_ENTRANCE_WIDTH = 6;
+    static constexpr int ENTRANCE_SPACING_DIVISOR = 4;
+
+    // Component labels are 16-bit, so a cluster may not have more cells
+    // than a label can count
+    static constexpr int MAX_CLUSTER_SIZE = 255;
+
+    // A move from a cell of the owning cluster to a cell of a neighbour
+    struct Transition {
+        int from;
+        int to;
+        Cost cost;
+    };
+
+    struct Link {
+        int cell;
+        Cost cost;
+    };
+
+    // Edge of the abstract graph, to entrance `entrance` of `cluster`
+    struct Arc {
+        int cluster;
+        int entrance;
+        Cost cost;
+    };
+
+    struct Cluster {
+        Maze::Rect area;
+
+        // Transitions owned by this cluster, towards the neighbour east,
+        // south, south-east and south-west of it
+        std::vector<Transition> east, south, southEast, southWest;
+
+        // Abstract graph, derived from the transitions of all 8 borders
+        std::vector<int> entrances;        // sorted grid indices
+        std::vector<int> linkStart;        // entrance i owns links [linkStart[i], linkStart[i + 1])
+        std::vector<Link> links;           // moves into neighbouring clusters
+        std::vector<Cost> intra;           // entrances^2 costs inside the cluster, NO_COST if apart
+
+        // Intra edges and links as the search walks them
+        std::vector<int> arcStart;
+        std::vector<Arc> arcs;
+    };
+
+    int clusterSize_;
+    int slotShift_ = 0;
+    int width_ = 0;
+    int height_ = 0;
+    int clustersX_ = 0;
+    int clustersY_ = 0;
+    std::uint64_t stamp_ = 0;
+    std::vector<Cluster> clusters_;
+    size_t lastRebuildCount_ = 0;
+
+    // Component of every cell within its cluster, 0 for walls
+    std::vector<std::uint16_t> component_;
+    std::vector<int> fill_;
+
+    // Abstract nodes: entrance i of cluster c is node nodeBase_[c] + i
+    std::vector<int> nodeBase_;
+    std::vector<int> nodeCluster_;
+    std::vector<Maze::Point> nodePoint_;
+
+    // Cluster-local search scratch. The cell (x, y) from a cluster's
+    // corner is slot (y << slotShift_) + x.
+    BasicSearchState<Cost> local_;
+    QuadHeap<std::uint64_t> localOpen_;
+    BucketQueue<Cost, OctileCost::DIAGONAL> dijkstraOpen_;
+    std::vector<int> entranceSlot_;
+    std::vector<Cost> distances_;
+
+    BasicSearchState<Cost> abstract_;
+    QuadHeap<std::uint64_t> abstractOpen_;
+    std::vector<Cost> startCosts_;
+    std::vector<Cost> goalCosts_;
+
+    int clusterOf(const Maze::Point& p) const {
+        return (p.y / clusterSize_) * clustersX_ + p.x / clusterSize_;
+    }
+
+    int slotOf(const Maze::Rect& area, const Maze::Point& p) const {
+        return ((p.y - area.y) << slotShift_) + (p.x - area.x);
+    }
+
+    Maze::Point pointOfSlot(const Maze::Rect& area, int slot) const {
+        return Maze::Point(area.x + (slot & ((1 << slotShift_) - 1)), area.y + (slot >> slotShift_));
+    }
+
+    // ---- Building -------------------------------------------------------
+
+    void update(const Maze& maze) {
+        const std::uint64_t stamp = maze.getWalkabilityStamp();
+        if (stamp == stamp_) {
+            lastRebuildCount_ = 0;
+            return;
+        }
+
+        Maze::Rect changed;
+        if (width_ == maze.getWidth() && height_ == maze.getHeight() &&
+            maze.getWalkabilityChanges(stamp_, changed)) {
+            rebuild(maze, changed);
+        } else {
+            build(maze);
+        }
+        stamp_ = stamp;
+    }
+
+    void build(const Maze& maze) {
+        width_ = maze.getWidth();
+        height_ = maze.getHeight();
+        clustersX_ = (width_ + clusterSize_ - 1) / clusterSize_;
+        clustersY_ = (height_ + clusterSize_ - 1) / clusterSize_;
+        clusters_.assign(static_cast<size_t>(clustersX_) * clustersY_, Cluster());
+        for (int cy = 0; cy < clustersY_; ++cy) {
+            for (int cx = 0; cx < clustersX_; ++cx) {
+                const int x = cx * clusterSize_;
+                const int y = cy * clusterSize_;
+                clusters_[cy * clustersX_ + cx].area =
+                    Maze::Rect(x, y, std::min(clusterSize_, width_ - x), std::min(clusterSize_, height_ - y));
+            }
+        }
+        component_.assign(static_cast<size_t>(width_) * height_, 0);
+        entranceSlot_.assign(size_t(1) << (2 * slotShift_), -1);
+        nodeBase_.clear();
+
+        rebuild(maze, Maze::Rect(0, 0, width_, height_));
+    }
+
+    // Recompute everything that can depend on the cells in `changed`
+    void rebuild(const Maze& maze, const Maze::Rect& changed) {
+        lastRebuildCount_ = 0;
+        if (changed.empty() || clusters_.empty()) return;
+
+        // Clusters whose cells changed
+        const int cx0 = std::max(changed.x, 0) / clusterSize_;
+        const int cy0 = std::max(changed.y, 0) / clusterSize_;
+        const int cx1 = std::min(changed.x + changed.width - 1, width_ - 1) / clusterSize_;
+        const int cy1 = std::min(changed.y + changed.height - 1, height_ - 1) / clusterSize_;
+
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            for (int cx = cx0; cx <= cx1; ++cx) {
+                labelComponents(maze, clusters_[cy * clustersX_ + cx].area);
+            }
+        }
+
+        // Every border touching them; each cluster owns its east, south
+        // and two southern corner borders
+        for (int cy = std::max(cy0 - 1, 0); cy <= cy1; ++cy) {
+            for (int cx = std::max(cx0 - 1, 0); cx <= std::min(cx1 + 1, clustersX_ - 1); ++cx) {
+                findTransitions(maze, cx, cy);
+            }
+        }
+
+        // Clusters on either side of those borders: relink, and rebuild the
+        // internal edges where cells or entrances changed
+        bool countsChanged = nodeBase_.size() != clusters_.size() + 1;
+        for (int cy = std::max(cy0 - 1, 0); cy <= std::min(cy1 + 1, clustersY_ - 1); ++cy) {
+            for (int cx = std::max(cx0 - 2, 0); cx <= std::min(cx1 + 2, clustersX_ - 1); ++cx) {
+                const int c = cy * clustersX_ + cx;
+                const bool cellsChanged = cx >= cx0 && cx <= cx1 && cy >= cy0 && cy <= cy1;
+                if (linkEntrances(cx, cy) || cellsChanged) {
+                    connectEntrances(maze, clusters_[c]);
+                    ++lastRebuildCount_;
+                }
+                countsChanged = countsChanged ||
+                                nodeBase_[c + 1] - nodeBase_[c] != static_cast<int>(clusters_[c].entrances.size());
+            }
+        }
+
+        // Arcs name entrances by position, so neighbours of any cluster
+        // whose entrances changed need theirs again
+        for (int cy = std::max(cy0 - 2, 0); cy <= std::min(cy1 + 2, clustersY_ - 1); ++cy) {
+            for (int cx = std::max(cx0 - 3, 0); cx <= std::min(cx1 + 3, clustersX_ - 1); ++cx) {
+                makeArcs(maze, cy * clustersX_ + cx);
+            }
+        }
+
+        if (countsChanged) {
+            numberNodes(maze);
+        } else {
+            for (int cy = std::max(cy0 - 1, 0); cy <= std::min(cy1 + 1, clustersY_ - 1); ++cy) {
+                for (int cx = std::max(cx0 - 2, 0); cx <= std::min(cx1 + 2, clustersX_ - 1); ++cx) {
+                    const int c = cy * clustersX_ + cx;
+                    for (size_t i = 0; i < clusters_[c].entrances.size(); ++i) {
+                        nodePoint_[nodeBase_[c] + i] = maze.pointAt(clusters_[c].entrances[i]);
+                    }
+                }
+            }
+        }
+    }
+
+    // Flood fill every walkable cell of `area` with a component label
+    void labelComponents(const Maze& maze, const Maze::Rect& area) {
+        for (int y = area.y; y < area.y + area.height; ++y) {
+            std::fill_n(component_.begin() + maze.index(area.x, y), area.width, std::uint16_t(0));
+        }
+
+        std::uint16_t label = 0;
+        for (int y = area.y; y < area.y + area.height; ++y) {
+            for (int x = area.x; x < area.x + area.width; ++x) {
+                if (component_[maze.index(x, y)] != 0 || !maze.isPassable(x, y)) continue;
+
+                component_[maze.index(x, y)] = ++label;
+                fill_.assign(1, slotOf(area, Maze::Point(x, y)));
+                while (!fill_.empty()) {
+                    const int slot = fill_.back();
+                    fill_.pop_back();
+                    expandSlot(maze, area, slot, [&](int neighbor, Cost) {
+                        const Maze::Point p = pointOfSlot(area, neighbor);
+                        std::uint16_t& cell = component_[maze.index(p.x, p.y)];
+                        if (cell == 0) {
+                            cell = label;
+                            fill_.push_back(neighbor);
+                        }
+                    });
+                }
+            }
+        }
+    }
+
+    void findTransitions(const Maze& maze, int cx, int cy) {
+        Cluster& cluster = clusters_[cy * clustersX_ + cx];
+        const Maze::Rect& area = cluster.area;
+        const int x1 = area.x + area.width;   // first column east of the cluster
+        const int y1 = area.y + area.height;  // first row south of the cluster
+        cluster.east.clear();
+        cluster.south.clear();
+        cluster.southEast.clear();
+        cluster.southWest.clear();
+
+        if (cx + 1 < clustersX_) {
+            findBorderTransitions(maze, Maze::Point(x1 - 1, area.y), 0, 1, area.height, cluster.east);
+        }
+        if (cy + 1 < clustersY_) {
+            findBorderTransitions(maze, Maze::Point(area.x, y1 - 1), 1, 0, area.width, cluster.south);
+        }
+
+        // Diagonal corner crossings that no straight crossing covers
+        if (cx + 1 < clustersX_ && cy + 1 < clustersY_ &&
+            maze.isPassable(x1 - 1, y1 - 1) && maze.isPassable(x1, y1) &&
+            !maze.isPassable(x1, y1 - 1) && !maze.isPassable(x1 - 1, y1)) {
+            cluster.southEast.push_back(Transition{maze.index(x1 - 1, y1 - 1), maze.index(x1, y1), OctileCost::DIAGONAL});
+        }
+        if (cx > 0 && cy + 1 < clustersY_ &&
+            maze.isPassable(area.x, y1 - 1) && maze.isPassable(area.x - 1, y1) &&
+            !maze.isPassable(area.x - 1, y1 - 1) && !maze.isPassable(area.x, y1)) {
+            cluster.southWest.push_back(Transition{maze.index(area.x, y1 - 1), maze.index(area.x - 1, y1), OctileCost::DIAGONAL});
+        }
+    }
+
+    // One border: `first` is the owning cluster's cell at the start of the
+    // border, (ax, ay) walks along it and the neighbour is one step across
+    void findBorderTransitions(const Maze& maze, const Maze::Point& first, int ax, int ay, int length,
+                               std::vector<Transition>& out) {
+        const int acrossX = ay;  // east border walks down, crosses right
+        const int acrossY = ax;  // south border walks right, crosses down
+        auto inside = [&](int i) { return Maze::Point(first.x + i * ax, first.y + i * ay); };
+        auto outside = [&](int i) { return Maze::Point(first.x + i * ax + acrossX, first.y + i * ay + acrossY); };
+        auto passable = [&](const Maze::Point& p) { return maze.isPassable(p.x, p.y); };
+        auto crossable = [&](int i) { return passable(inside(i)) && passable(outside(i)); };
+
+        // Candidates, each from an opening of some width at some position
+        struct Candidate {
+            Transition transition;
+            int opening;
+            int width;
+            int position;
+        };
+        std::vector<Candidate> candidates;
+        int openings = 0;
+        auto add = [&](int i, const Maze::Point& b, Cost cost, int width) {
+            const Maze::Point a = inside(i);
+            candidates.push_back(Candidate{Transition{maze.index(a.x, a.y), maze.index(b.x, b.y), cost},
+                                           openings, width, i});
+        };
+
+        // Runs of straight crossings
+        for (int i = 0; i < length; ) {
+            if (!crossable(i)) {
+                ++i;
+                continue;
+            }
+            int end = i;
+            while (end + 1 < length && crossable(end + 1)) ++end;
+            if (end - i + 1 < MAX_ENTRANCE_WIDTH) {
+                const int middle = (i + end) / 2;
+                add(middle, outside(middle), OctileCost::STRAIGHT, end - i + 1);
+            } else {
+                add(i, outside(i), OctileCost::STRAIGHT, end - i + 1);
+                add(end, outside(end), OctileCost::STRAIGHT, end - i + 1);
+            }
+            ++openings;
+            i = end + 1;
+        }
+
+        // Diagonal crossings between two blocked straight ones
+        for (int i = 0; i + 1 < length; ++i) {
+            if (passable(inside(i)) && passable(outside(i + 1)) &&
+                !passable(outside(i)) && !passable(inside(i + 1))) {
+                add(i, outside(i + 1), OctileCost::DIAGONAL, 0);
+                ++openings;
+            }
+            if (passable(inside(i + 1)) && passable(outside(i)) &&
+                !passable(inside(i)) && !passable(outside(i + 1))) {
+                add(i + 1, outside(i), OctileCost::DIAGONAL, 0);
+                ++openings;
+            }
+        }
+
+        // Widest openings first; skip one whose components are already
+        // joined by a kept opening nearby along the border
+        std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+            return a.width > b.width;
+        });
+        std::vector<Candidate> kept;
+        for (const Candidate& candidate : candidates) {
+            bool redundant = false;
+            for (const Candidate& other : kept) {
+                if (other.opening != candidate.opening &&
+                    component_[other.transition.from] == component_[candidate.transition.from] &&
+                    component_[other.transition.to] == component_[candidate.transition.to] &&
+                    std::abs(other.position - candidate.position) < clusterSize_ / ENTRANCE_SPACING_DIVISOR) {
+                    redundant = true;
+                    break;
+                }
+            }
+            if (!redundant) {
+                kept.push_back(candidate);
+                out.push_back(candidate.transition);
+            }
+        }
+    }
+
+    // Gather this cluster's end of every transition on its 8 borders.
+    // Returns whether the set of entrance cells changed.
+    bool linkEntrances(int cx, int cy) {
+        std::vector<std::pair<int, Link>> ends;
+        auto collect = [&](int nx, int ny, std::vector<Transition> Cluster::*border, bool owner) {
+            if (nx < 0 || ny < 0 || nx >= clustersX_ || ny >= clustersY_) return;
+            for (const Transition& t : clusters_[ny * clustersX_ + nx].*border) {
+                if (owner) {
+                    ends.push_back({t.from, Link{t.to, t.cost}});
+                } else {
+                    ends.push_back({t.to, Link{t.from, t.cost}});
+                }
+            }
+        };
+        collect(cx, cy, &Cluster::east, true);
+        collect(cx, cy, &Cluster::south, true);
+        collect(cx, cy, &Cluster::southEast, true);
+        collect(cx, cy, &Cluster::southWest, true);
+        collect(cx - 1, cy, &Cluster::east, false);
+        collect(cx, cy - 1, &Cluster::south, false);
+        collect(cx - 1, cy - 1, &Cluster::southEast, false);
+        collect(cx + 1, cy - 1, &Cluster::southWest, false);
+
+        std::sort(ends.begin(), ends.end(), [](const auto& a, const auto& b) {
+            return a.first != b.first ? a.first < b.first : a.second.cell < b.second.cell;
+        });
+
+        Cluster& cluster = clusters_[cy * clustersX_ + cx];
+        std::vector<int> entrances;
+        cluster.linkStart.clear();
+        cluster.links.clear();
+        for (const auto& end : ends) {
+            if (entrances.empty() || entrances.back() != end.first) {
+                entrances.push_back(end.first);
+                cluster.linkStart.push_back(static_cast<int>(cluster.links.size()));
+            }
+            cluster.links.push_back(end.second);
+        }
+        cluster.linkStart.push_back(static_cast<int>(cluster.links.size()));
+
+        const bool changed = entrances != cluster.entrances;
+        cluster.entrances.swap(entrances);
+        return changed;
+    }
+
+    // Exact costs between all entrances of a cluster, moving only inside it
+    void connectEntrances(const Maze& maze, Cluster& cluster) {
+        const size_t count = cluster.entrances.size();
+        cluster.intra.assign(count * count, NO_COST);
+        for (size_t i = 0; i < count; ++i) {
+            cluster.intra[i * count + i] = 0;
+            if (i + 1 == count) break;
+            distancesFrom(maze, cluster, maze.pointAt(cluster.entrances[i]), distances_, i + 1);
+            for (size_t j = i + 1; j < count; ++j) {
+                cluster.intra[i * count + j] = distances_[j];
+                cluster.intra[j * count + i] = distances_[j];
+            }
+        }
+    }
+
+    void makeArcs(const Maze& maze, int c) {
+        Cluster& cluster = clusters_[c];
+        const size_t count = cluster.entrances.size();
+        cluster.arcStart.clear();
+        cluster.arcs.clear();
+        for (size_t i = 0; i < count; ++i) {
+            cluster.arcStart.push_back(static_cast<int>(cluster.arcs.size()));
+            for (size_t j = 0; j < count; ++j) {
+                const Cost cost = cluster.intra[i * count + j];
+                if (j != i && cost != NO_COST) cluster.arcs.push_back(Arc{c, static_cast<int>(j), cost});
+            }
+            for (int l = cluster.linkStart[i]; l < cluster.linkStart[i + 1]; ++l) {
+                const int target = clusterOf(maze.pointAt(cluster.links[l].cell));
+                const std::vector<int>& entrances = clusters_[target].entrances;
+                const auto slot = std::lower_bound(entrances.begin(), entrances.end(), cluster.links[l].cell);
+                cluster.arcs.push_back(Arc{target, static_cast<int>(slot - entrances.begin()), cluster.links[l].cost});
+            }
+        }
+        cluster.arcStart.push_back(static_cast<int>(cluster.arcs.size()));
+    }
+
+    void numberNodes(const Maze& maze) {
+        nodeBase_.assign(1, 0);
+        nodeCluster_.clear();
+        nodePoint_.clear();
+        for (size_t c = 0; c < clusters_.size(); ++c) {
+            for (int cell : clusters_[c].entrances) {
+                nodeCluster_.push_back(static_cast<int>(c));
+                nodePoint_.push_back(maze.pointAt(cell));
+            }
+            nodeBase_.push_back(static_cast<int>(nodePoint_.size()));
+        }
+    }
+
+    // ---- Searching ------------------------------------------------------
+
+    // Dijkstra from `source` inside the cluster; distances[j] is the cost
+    // to entrance j or NO_COST. Stops once every entrance from `first` on
+    // in the source's component is reached.
+    void distancesFrom(const Maze& maze, const Cluster& cluster, const Maze::Point& source,
+                       std::vector<Cost>& distances, size_t first = 0) {
+        const size_t count = cluster.entrances.size();
+        const std::uint16_t component = component_[maze.index(source.x, source.y)];
+        distances.assign(count, NO_COST);
+        size_t remaining = 0;
+        for (size_t j = first; j < count; ++j) {
+            remaining += component_[cluster.entrances[j]] == component;
+        }
+        if (remaining == 0) return;
+
+        for (size_t j = 0; j < count; ++j) {
+            entranceSlot_[slotOf(cluster.area, maze.pointAt(cluster.entrances[j]))] = static_cast<int>(j);
+        }
+
+        const size_t slots = entranceSlot_.size();
+        const int sourceSlot = slotOf(cluster.area, source);
+        local_.reset(slots);
+        dijkstraOpen_.reset(slots);
+        local_.open(sourceSlot, 0, BasicSearchState<Cost>::NO_PARENT);
+        dijkstraOpen_.push(sourceSlot, 0);
+
+        while (!dijkstraOpen_.empty() && remaining > 0) {
+            const int current = dijkstraOpen_.pop();
+            local_.close(current);
+            const Cost g = local_.cost(current);
+
+            const int j = entranceSlot_[current];
+            if (j >= 0) {
+                distances[j] = g;
+                remaining -= static_cast<size_t>(j) >= first;
+            }
+
+            expandSlot(maze, cluster.area, current, [&](int neighbor, Cost step) {
+                const Cost tentative = g + step;
+                if (!local_.visited(neighbor) || tentative < local_.cost(neighbor)) {
+                    local_.open(neighbor, tentative, current);
+                    dijkstraOpen_.pushOrDecrease(neighbor, tentative);
+                }
+            });
+        }
+
+        for (int cell : cluster.entrances) {
+            entranceSlot_[slotOf(cluster.area, maze.pointAt(cell))] = -1;
+        }
+    }
+
+    // A* from `from` to `to` inside `area`. Appends the cells after `from`
+    // to path when given; returns whether `to` was reached.
+    bool localSearch(const Maze& maze, const Maze::Rect& area, const Maze::Point& from, const Maze::Point& to,
+                     std::vector<Maze::Point>* path, size_t& nodesExplored) {
+        auto estimate = [&](int slot) {
+            const Maze::Point p = pointOfSlot(area, slot);
+            return OctileHeuristic::estimate<Cost>(std::abs(p.x - to.x), std::abs(p.y - to.y));
+        };
+
+        const size_t slots = entranceSlot_.size();
+        const int fromSlot = slotOf(area, from);
+        const int toSlot = slotOf(area, to);
+        local_.reset(slots);
+        localOpen_.reset(slots);
+        local_.open(fromSlot, 0, BasicSearchState<Cost>::NO_PARENT);
+        localOpen_.push(fromSlot, PreferLargerG::key(estimate(fromSlot), Cost(0)));
+
+        while (!localOpen_.empty()) {
+            if (limitReached(nodesExplored)) return false;
+            const int current = localOpen_.pop();
+            local_.close(current);
+            ++nodesExplored;
+            const Cost g = local_.cost(current);
+
+            if (current == toSlot) {
+                if (path) {
+                    const size_t begin = path->size();
+                    for (int slot = toSlot; slot != fromSlot; slot = local_.parent(slot)) {
+                        path->push_back(pointOfSlot(area, slot));
+                    }
+                    std::reverse(path->begin() + begin, path->end());
+                }
+                return true;
+            }
+
+            expandSlot(maze, area, current, [&](int neighbor, Cost step) {
+                const Cost tentative = g + step;
+                if (!local_.visited(neighbor) || tentative < local_.cost(neighbor)) {
+                    local_.open(neighbor, tentative, current);
+                    local_.reopen(neighbor);
+                    localOpen_.pushOrDecrease(neighbor, PreferLargerG::key(tentative + estimate(neighbor), tentative));
+                }
+            });
+        }
+        return false;
+    }
+
+    // Walkable 8-neighbours of a slot that lie inside `area`
+    template<typename Visit>
+    void expandSlot(const Maze& maze, const Maze::Rect& area, int slot, Visit&& visit) const {
+        const int x = slot & ((1 << slotShift_) - 1);
+        const int y = slot >> slotShift_;
+        unsigned mask = maze.getNeighborMask(maze.index(area.x + x, area.y + y));
+        for (; mask != 0; mask &= mask - 1) {
+            const int d = countTrailingZeros(static_cast<std::uint32_t>(mask));
+            const int nx = x + EightNeighborhood::DX[d];
+            const int ny = y + EightNeighborhood::DY[d];
+            if (nx < 0 || ny < 0 || nx >= area.width || ny >= area.height) continue;
+            visit((ny << slotShift_) + nx, OctileCost::step(EightNeighborhood::DX[d], EightNeighborhood::DY[d]));
+        }
+    }
+
+    // A* over the entrance nodes, with start and goal as two extra nodes
+    // linked into their clusters. Returns the abstract path, start to goal,
+    // or nothing.
+    std::vector<Maze::Point> abstractSearch(const Maze& maze, const Maze::Point& start, const Maze::Point& goal,
+                                            bool visualize, VisualizationCallback callback, size_t& nodesExplored) {
+        const int startCluster = clusterOf(start);
+        const int goalCluster = clusterOf(goal);
+        distancesFrom(maze, clusters_[startCluster], start, startCosts_);
+        distancesFrom(maze, clusters_[goalCluster], goal, goalCosts_);
+
+        const int startNode = nodeBase_.back();
+        const int goalNode = startNode + 1;
+        auto pointOf = [&](int node) {
+            return node == startNode ? start : node == goalNode ? goal : nodePoint_[node];
+        };
+        auto estimate = [&](int node) {
+            const Maze::Point p = pointOf(node);
+            return OctileHeuristic::estimate<Cost>(std::abs(p.x - goal.x), std::abs(p.y - goal.y));
+        };
+        auto pathTo = [&](int node) {
+            std::vector<Maze::Point> path;
+            for (; node != BasicSearchState<Cost>::NO_PARENT; node = abstract_.parent(node)) {
+                path.push_back(pointOf(node));
+            }
+            std::reverse(path.begin(), path.end());
+            return path;
+        };
+
+        abstract_.reset(static_cast<size_t>(goalNode) + 1);
+        abstractOpen_.reset(static_cast<size_t>(goalNode) + 1);
+        abstract_.open(startNode, 0, BasicSearchState<Cost>::NO_PARENT);
+        abstractOpen_.push(startNode, PreferLargerG::key(estimate(startNode), Cost(0)));
+
+        while (!abstractOpen_.empty()) {
+            if (limitReached(nodesExplored)) return {};
+            const int current = abstractOpen_.pop();
+            abstract_.close(current);
+            ++nodesExplored;
+            const Cost g = abstract_.cost(current);
+            if (getTrace()) {
+                const Maze::Point point = pointOf(current);
+                traceExpansion(maze.index(point.x, point.y));
+            }
+
+            // Visualize current step
+            if (visualize) {
+                visualizeStep(pointOf(current), pathTo(current), visualize, callback);
+            }
+
+            if (current == goalNode) {
+                return pathTo(goalNode);
+            }
+
+            auto relax = [&](int next, Cost cost) {
+                if (cost == NO_COST) return;
+                const Cost tentative = g + cost;
+                if (!abstract_.visited(next) || tentative < abstract_.cost(next)) {
+                    abstract_.open(next, tentative, current);
+                    abstract_.reopen(next);
+                    abstractOpen_.pushOrDecrease(next, PreferLargerG::key(tentative + estimate(next), tentative));
+                }
+            };
+
+            if (current == startNode) {
+                for (size_t j = 0; j < startCosts_.size(); ++j) {
+                    relax(nodeBase_[startCluster] + static_cast<int>(j), startCosts_[j]);
+                }
+                continue;
+            }
+
+            const int c = nodeCluster_[current];
+            const int i = current - nodeBase_[c];
+            const Cluster& cluster = clusters_[c];
+            for (int a = cluster.arcStart[i]; a < cluster.arcStart[i + 1]; ++a) {
+                const Arc& arc = cluster.arcs[a];
+                relax(nodeBase_[arc.cluster] + arc.entrance, arc.cost);
+            }
+            if (c == goalCluster) {
+                relax(goalNode, goalCosts_[i]);
+            }
+        }
+        return {};
+    }
+
+    size_t memoryUsage() const {
+        size_t bytes = clusters_.capacity() * sizeof(Cluster);
+        for (const Cluster& cluster : clusters_) {
+            bytes += (cluster.east.capacity() + cluster.south.capacity() +
+                      cluster.southEast.capacity() + cluster.southWest.capacity()) * sizeof(Transition) +
+                     (cluster.entrances.capacity() + cluster.linkStart.capacity() +
+                      cluster.arcStart.capacity()) * sizeof(int) +
+                     cluster.links.capacity() * sizeof(Link) + cluster.intra.capacity() * sizeof(Cost) +
+                     cluster.arcs.capacity() * sizeof(Arc);
+        }
+        bytes += component_.capacity() * sizeof(std::uint16_t) +
+                 (nodeBase_.capacity() + nodeCluster_.capacity() + entranceSlot_.capacity()) * sizeof(int) +
+                 nodePoint_.capacity() * sizeof(Maze::Point);
+        return bytes + local_.memoryUsage() + localOpen_.memoryUsage() + dijkstraOpen_.memoryUsage() +
+               abstract_.memoryUsage() + abstractOpen_.memoryUsage();
+    }
+};
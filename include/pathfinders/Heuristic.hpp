@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CostModel.hpp"
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+// Heuristic policies. estimate() receives the absolute x/y distance to the
+// goal and returns a value in the cost type of the search.
+
+// No guidance at all; turns a best-first search into Dijkstra or BFS
+struct ZeroHeuristic {
+    template<typename Cost>
+    static Cost estimate(int /*dx*/, int /*dy*/) { return Cost(0); }
+};
+
+// Straight-line distance
+struct EuclideanHeuristic {
+    template<typename Cost>
+    static Cost estimate(int dx, int dy) {
+        return static_cast<Cost>(std::sqrt(static_cast<double>(dx) * dx + static_cast<double>(dy) * dy));
+    }
+};
+
+// Exact distance on an obstacle-free 8-connected grid in OctileCost units
+struct OctileHeuristic {
+    template<typename Cost>
+    static Cost estimate(int dx, int dy) {
+        return static_cast<Cost>(octileDistance<OctileCost>(dx, dy));
+    }
+};
+
+// Tie-breaking policies. key() turns f = g + h and g into the open-list key,
+// so they decide which of several equally promising cells is expanded first.
+
+// Plain f; ties fall to whatever order the open list happens to produce
+struct NoTieBreak {
+    template<typename Cost>
+    static Cost key(Cost f, Cost /*g*/) { return f; }
+};
+
+// Among equal f prefer the larger g, i.e. the cell closest to the goal. On
+// open maps this walks straight down one of the many equal-cost paths
+// instead of fanning out over all of them. f and g must be non-negative
+// 32-bit integers; they are packed into one 64-bit key so the open list
+// still does a single integer comparison.
+struct PreferLargerG {
+    template<typename Cost>
+    static std::uint64_t key(Cost f, Cost g) {
+        static_assert(std::is_integral<Cost>::value, "PreferLargerG needs an integer cost model");
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(f)) << 32) |
+               (UINT32_MAX - static_cast<std::uint32_t>(g));
+    }
+};
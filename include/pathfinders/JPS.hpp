@@ -1,77 +1,216 @@
 #pragma once
 
 #include "Pathfinder.hpp"
-#include <queue>
-#include <unordered_map>
-#include <cmath>
+#include "OpenList.hpp"
+#include "CostModel.hpp"
+#include "Heuristic.hpp"
+#include "Bits.hpp"
 #include <bits/stdc++.h>
 
-class JPS : public Pathfinder {
-public:
-    struct Node {
-        Maze::Point point;
-        double f_score;
-        double g_score;
+// Block-based straight jumps (Harabor & Grastien, "Improving Jump Point
+// Search", 2014). A run along a row or column is scanned 64 cells at a time
+// over the maze's packed bit lines. A cell is a jump point when a side cell
+// is blocked and the next cell on that side is open (a forced neighbour);
+// the run dies at the first blocked cell.
+struct JumpScanner {
+    // First jump point after `pos` along `line` in direction `dir` (+1 or
+    // -1), or -1 when a wall comes first. sideA and sideB are the two
+    // adjacent lines. `stopAt` is a position that ends the run by itself
+    // (the goal, if it lies on this line) or -1.
+    static int jump(const std::uint64_t* line, const std::uint64_t* sideA, const std::uint64_t* sideB,
+                    int pos, int dir, int stopAt) {
+        if (dir > 0) {
+            for (int bit = Maze::BITMAP_OFFSET + pos + 1; ; bit += 64) {
+                const std::uint64_t open = readBits(line, bit);
+                const std::uint64_t forced = (~readBits(sideA, bit) & readBits(sideA, bit + 1)) |
+                                             (~readBits(sideB, bit) & readBits(sideB, bit + 1));
+                const std::uint64_t stop = ~open | forced;
+                if (stop == 0) continue;
+
+                const int offset = countTrailingZeros(stop);
+                const int cell = bit + offset - Maze::BITMAP_OFFSET;
+                if (stopAt > pos && stopAt <= cell) return stopAt;
+                return ((open >> offset) & 1) ? cell : -1;
+            }
+        }
+
+        // Leftwards / upwards: windows end at `bit` and are scanned from the top
+        for (int bit = Maze::BITMAP_OFFSET + pos - 1; ; bit -= 64) {
+            const std::uint64_t open = readBits(line, bit - 63);
+            const std::uint64_t forced = (~readBits(sideA, bit - 63) & readBits(sideA, bit - 64)) |
+                                         (~readBits(sideB, bit - 63) & readBits(sideB, bit - 64));
+            const std::uint64_t stop = ~open | forced;
+            if (stop == 0) continue;
+
+            const int offset = countLeadingZeros(stop);
+            const int cell = bit - offset - Maze::BITMAP_OFFSET;
+            if (stopAt >= 0 && stopAt < pos && stopAt >= cell) return stopAt;
+            return ((open >> (63 - offset)) & 1) ? cell : -1;
+        }
+    }
+};
+
+// Jump policy of plain JPS: every jump is computed online. A jump policy
+// provides
+//
+//   update(maze)           bring any per-map data in line with the maze
+//   jump(maze, node, dx, dy, goal)
+//                          next jump point from node in direction (dx, dy),
+//                          or (-1, -1) when the run dies first
+//   save / load / memoryUsage
+//                          persistence of per-map data (see Pathfinder)
+//   HAS_TABLES             whether there is per-map data to share
+struct BlockJumper {
+    static constexpr bool HAS_TABLES = false;
 
-        Node(const Maze::Point& p, double f, double g)
-            : point(p), f_score(f), g_score(g) {}
+    void update(const Maze& /*maze*/) {}
+    bool save(const Maze& /*maze*/, const std::string& /*path*/) { return false; }
+    bool load(const Maze& /*maze*/, const std::string& /*path*/) { return false; }
+    size_t memoryUsage() const { return 0; }
 
-        bool operator>(const Node& other) const {
-            return f_score > other.f_score;
+    Maze::Point jump(const Maze& maze, const Maze::Point& node, int dx, int dy, const Maze::Point& goal) const {
+        if (dx != 0 && dy != 0) return jumpDiagonal(maze, node, dx, dy, goal);
+        if (dx != 0) {
+            const int x = jumpHorizontal(maze, node, dx, goal);
+            return x == -1 ? Maze::Point(-1, -1) : Maze::Point(x, node.y);
         }
-    };
+        const int y = jumpVertical(maze, node, dy, goal);
+        return y == -1 ? Maze::Point(-1, -1) : Maze::Point(node.x, y);
+    }
+
+    // Straight runs are block scans over the maze's row and column bit lines
+    static int jumpHorizontal(const Maze& maze, const Maze::Point& node, int dx, const Maze::Point& goal) {
+        return JumpScanner::jump(maze.getRowBits(node.y), maze.getRowBits(node.y - 1), maze.getRowBits(node.y + 1),
+                                 node.x, dx, goal.y == node.y ? goal.x : -1);
+    }
+
+    static int jumpVertical(const Maze& maze, const Maze::Point& node, int dy, const Maze::Point& goal) {
+        return JumpScanner::jump(maze.getColumnBits(node.x), maze.getColumnBits(node.x - 1), maze.getColumnBits(node.x + 1),
+                                 node.y, dy, goal.x == node.x ? goal.y : -1);
+    }
+
+    // Diagonal runs step one cell at a time and stop wherever either
+    // straight scan finds something; no recursion, so the stack depth no
+    // longer grows with the map
+    static Maze::Point jumpDiagonal(const Maze& maze, Maze::Point node, int dx, int dy, const Maze::Point& goal) {
+        while (true) {
+            node = Maze::Point(node.x + dx, node.y + dy);
+
+            // The padded border stops every run
+            if (!maze.isPassable(node.x, node.y)) return Maze::Point(-1, -1);
+            if (node == goal) return node;
+
+            // Forced neighbours around a diagonal step
+            if (!maze.isPassable(node.x - dx, node.y) || !maze.isPassable(node.x, node.y - dy)) return node;
+
+            if (jumpHorizontal(maze, node, dx, goal) != -1 || jumpVertical(maze, node, dy, goal) != -1) {
+                return node;
+            }
+        }
+    }
+};
+
+// Jump Point Search over a pluggable open list (see OpenList.hpp). Jump
+// points are joined by straight or diagonal runs, so both the distance
+// between them and the heuristic are octile distances in CostModel units.
+// The cost model and tie-breaking policy are the same ones the best-first
+// core uses; the open list's key type must match TieBreak::key(). Jumper
+// decides how jumps are found (BlockJumper scans, JumpTable looks up).
+template<typename OpenList, typename CostModel = EuclideanCost, typename TieBreak = NoTieBreak,
+         typename Jumper = BlockJumper>
+class BasicJPS : public Pathfinder {
+public:
+    using Cost = typename CostModel::Cost;
+
+    explicit BasicJPS(std::string name = withOpenListName<OpenList>("Jump Point Search"))
+        : name_(std::move(name)) {}
+
+    void prepare(const Maze& maze) override {
+        jumper_->update(maze);
+    }
+
+    bool savePreprocessing(const Maze& maze, const std::string& mazePath) override {
+        return jumper_->save(maze, mazePath);
+    }
+
+    bool loadPreprocessing(const Maze& maze, const std::string& mazePath) override {
+        return jumper_->load(maze, mazePath);
+    }
 
-    PathfindingResult findPath(const Maze& maze, bool visualize = false, 
-                              VisualizationCallback callback = nullptr) override {
+    bool sharePreprocessing(const Pathfinder& source) override {
+        if constexpr (!Jumper::HAS_TABLES) return false;
+        const auto* other = dynamic_cast<const BasicJPS*>(&source);
+        if (other == nullptr || other == this) return false;
+        jumper_ = other->jumper_;
+        return true;
+    }
+
+protected:
+    PathfindingResult search(const Maze& maze, const Maze::Point& start, const Maze::Point& goal,
+                             bool visualize, VisualizationCallback callback) override {
         auto start_time = std::chrono::high_resolution_clock::now();
         PathfindingResult result;
         result.nodesExplored = 0;
 
-        Maze::Point start = maze.getStart();
-        Maze::Point goal = maze.getGoal();
+        if (!hasValidEndpoints(maze, start, goal) || !mayBeReachable(maze, start, goal)) return result;
+        jumper_->update(maze);
+
+        const int startIndex = maze.index(start.x, start.y);
+        const int goalIndex = maze.index(goal.x, goal.y);
 
-        // Priority queue for open set
-        std::priority_queue<Node, std::vector<Node>, std::greater<Node>> openSet;
+        // Open set keyed by f = g + h, each jump point present at most once
+        const size_t cellCount = maze.getWidth() * maze.getHeight();
+        openSet_.reset(cellCount);
         
-        // Maps for tracking
-        std::unordered_map<Maze::Point, Maze::Point> cameFrom;
-        std::unordered_map<Maze::Point, double> gScore;
+        // Dense per-cell tracking, reused across queries
+        state_.reset(cellCount);
         
         // Initialize start node
-        openSet.push(Node(start, heuristic(start, goal), 0.0));
-        gScore[start] = 0.0;
+        openSet_.push(startIndex, TieBreak::key(heuristic(start, goal), Cost(0)));
+        state_.open(startIndex, Cost(0), BasicSearchState<Cost>::NO_PARENT);
+
+        while (!openSet_.empty()) {
+            if (limitReached(result.nodesExplored)) {
+                result.path = expandJumps(partialPath(state_, maze));
+                result.pathLength = result.path.size();
+                break;
+            }
 
-        while (!openSet.empty()) {
-            Node current = openSet.top();
-            openSet.pop();
+            const int currentIndex = openSet_.pop();
+            const Maze::Point current = maze.pointAt(currentIndex);
+            const Cost currentG = state_.cost(currentIndex);
+            state_.close(currentIndex);
             result.nodesExplored++;
+            traceExpansion(currentIndex);
+            noteExpansion(maze, currentIndex);
 
             // Visualize current step
             if (visualize) {
-                std::vector<Maze::Point> currentPath;
-                if (!cameFrom.empty()) {
-                    currentPath = reconstructPath(cameFrom, start, current.point);
-                }
-                visualizeStep(current.point, currentPath, visualize, callback);
+                std::vector<Maze::Point> currentPath = expandJumps(reconstructPath(state_, maze, currentIndex));
+                visualizeStep(current, currentPath, visualize, callback);
             }
 
             // Found the goal
-            if (current.point == goal) {
-                result.path = reconstructPath(cameFrom, start, goal);
+            if (currentIndex == goalIndex) {
+                result.path = expandJumps(reconstructPath(state_, maze, goalIndex));
                 result.pathLength = result.path.size();
                 break;
             }
 
             // Get successors using jump point search
-            auto successors = findSuccessors(maze, current.point, goal);
-            for (const auto& successor : successors) {
-                double tentative_g = current.g_score + distance(current.point, successor);
-
-                if (!gScore.count(successor) || tentative_g < gScore[successor]) {
-                    cameFrom[successor] = current.point;
-                    gScore[successor] = tentative_g;
-                    double f = tentative_g + heuristic(successor, goal);
-                    openSet.push(Node(successor, f, tentative_g));
+            Maze::Point successors[8];
+            const int successorCount = findSuccessors(maze, currentIndex, current, goal, successors);
+            for (int s = 0; s < successorCount; ++s) {
+                const Maze::Point& successor = successors[s];
+                const Cost tentative_g = currentG + distance(current, successor);
+
+                const int successorIndex = maze.index(successor.x, successor.y);
+                if (!state_.visited(successorIndex) || tentative_g < state_.cost(successorIndex)) {
+                    state_.open(successorIndex, tentative_g, currentIndex);
+                    state_.reopen(successorIndex);
+                    traceParent(successorIndex, currentIndex);
+                    openSet_.pushOrDecrease(successorIndex,
+                                            TieBreak::key(tentative_g + heuristic(successor, goal), tentative_g));
                 }
             }
         }
@@ -81,91 +220,109 @@ public:
         result.executionTime = std::chrono::duration<double, std::milli>(end_time - start_time).count();
         
         // Get memory usage
-        result.memoryUsage = getCurrentMemoryUsage();
+        result.memoryUsage = getCurrentMemoryUsage() + state_.memoryUsage() + openSet_.memoryUsage() +
+                             jumper_->memoryUsage();
 
         return result;
     }
 
+public:
     std::string getName() const override {
-        return "Jump Point Search";
+        return name_;
     }
 
 private:
-    std::vector<Maze::Point> findSuccessors(const Maze& maze, const Maze::Point& node, const Maze::Point& goal) {
-        std::vector<Maze::Point> successors;
-        
-        // Check in all 8 directions
-        for (int dx = -1; dx <= 1; ++dx) {
-            for (int dy = -1; dy <= 1; ++dy) {
-                if (dx == 0 && dy == 0) continue;
-
-                Maze::Point jumpPoint = jump(maze, node, dx, dy, goal);
-                if (jumpPoint.x != -1) {  // Valid jump point found
-                    successors.push_back(jumpPoint);
+    std::string name_;
+    BasicSearchState<Cost> state_;
+    OpenList openSet_;
+    std::shared_ptr<Jumper> jumper_ = std::make_shared<Jumper>();
+
+    // Jump points are joined by straight or diagonal runs; fill in the cells
+    // between them so the result is a continuous cell-by-cell path
+    std::vector<Maze::Point> expandJumps(const std::vector<Maze::Point>& jumpPoints) const {
+        std::vector<Maze::Point> path;
+        for (size_t i = 0; i < jumpPoints.size(); ++i) {
+            if (i > 0) {
+                Maze::Point from = jumpPoints[i - 1];
+                int dx = (jumpPoints[i].x > from.x) - (jumpPoints[i].x < from.x);
+                int dy = (jumpPoints[i].y > from.y) - (jumpPoints[i].y < from.y);
+                for (Maze::Point p(from.x + dx, from.y + dy); p != jumpPoints[i]; p = Maze::Point(p.x + dx, p.y + dy)) {
+                    path.push_back(p);
                 }
             }
+            path.push_back(jumpPoints[i]);
         }
-        
-        return successors;
+        return path;
     }
 
-    Maze::Point jump(const Maze& maze, const Maze::Point& node, int dx, int dy, const Maze::Point& goal) {
-        Maze::Point next(node.x + dx, node.y + dy);
+    // Jump points reachable from node. The start expands all 8 directions;
+    // any other node only continues its incoming direction plus the
+    // directions opened up by forced neighbours (Harabor & Grastien, 2011).
+    int findSuccessors(const Maze& maze, int nodeIndex, const Maze::Point& node, const Maze::Point& goal,
+                       Maze::Point (&successors)[8]) const {
+        int directions[8][2];
+        int directionCount = 0;
+        auto addDirection = [&](int dx, int dy) {
+            directions[directionCount][0] = dx;
+            directions[directionCount][1] = dy;
+            ++directionCount;
+        };
 
-        // Check if next point is valid
-        if (!maze.isValidCell(next.x, next.y) || !maze.isWalkable(next.x, next.y)) {
-            return Maze::Point(-1, -1);
+        const int parentIndex = state_.parent(nodeIndex);
+        if (parentIndex == BasicSearchState<Cost>::NO_PARENT) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                for (int dy = -1; dy <= 1; ++dy) {
+                    if (dx != 0 || dy != 0) addDirection(dx, dy);
+                }
+            }
+        } else {
+            const Maze::Point parent = maze.pointAt(parentIndex);
+            const int dx = (node.x > parent.x) - (node.x < parent.x);
+            const int dy = (node.y > parent.y) - (node.y < parent.y);
+            if (dx != 0 && dy != 0) {
+                addDirection(dx, dy);
+                addDirection(dx, 0);
+                addDirection(0, dy);
+                if (!maze.isPassable(node.x - dx, node.y)) addDirection(-dx, dy);
+                if (!maze.isPassable(node.x, node.y - dy)) addDirection(dx, -dy);
+            } else if (dx != 0) {
+                addDirection(dx, 0);
+                if (!maze.isPassable(node.x, node.y + 1)) addDirection(dx, 1);
+                if (!maze.isPassable(node.x, node.y - 1)) addDirection(dx, -1);
+            } else {
+                addDirection(0, dy);
+                if (!maze.isPassable(node.x + 1, node.y)) addDirection(1, dy);
+                if (!maze.isPassable(node.x - 1, node.y)) addDirection(-1, dy);
+            }
         }
 
-        // Found goal
-        if (next == goal) {
-            return next;
-        }
+        int count = 0;
+        for (int d = 0; d < directionCount; ++d) {
+            const int dx = directions[d][0];
+            const int dy = directions[d][1];
 
-        // Check for forced neighbors
-        if (hasForcedNeighbor(maze, next, dx, dy)) {
-            return next;
-        }
-
-        // Diagonal movement
-        if (dx != 0 && dy != 0) {
-            // Check horizontal and vertical
-            if (jump(maze, next, dx, 0, goal).x != -1 || 
-                jump(maze, next, 0, dy, goal).x != -1) {
-                return next;
+            const Maze::Point jumpPoint = jumper_->jump(maze, node, dx, dy, goal);
+            if (jumpPoint.x != -1) {  // Valid jump point found
+                successors[count++] = jumpPoint;
             }
         }
-
-        // Continue jumping
-        return jump(maze, next, dx, dy, goal);
+        return count;
     }
 
-    bool hasForcedNeighbor(const Maze& maze, const Maze::Point& node, int dx, int dy) {
-        // Check for forced neighbors based on direction
-        if (dx != 0 && dy != 0) {  // Diagonal movement
-            // Check for blocked cells that create forced neighbors
-            bool blocked_hor = !maze.isWalkable(node.x - dx, node.y);
-            bool blocked_ver = !maze.isWalkable(node.x, node.y - dy);
-            return blocked_hor || blocked_ver;
-        } else if (dx != 0) {  // Horizontal movement
-            return (!maze.isWalkable(node.x, node.y + 1) && maze.isWalkable(node.x + dx, node.y + 1)) ||
-                   (!maze.isWalkable(node.x, node.y - 1) && maze.isWalkable(node.x + dx, node.y - 1));
-        } else if (dy != 0) {  // Vertical movement
-            return (!maze.isWalkable(node.x + 1, node.y) && maze.isWalkable(node.x + 1, node.y + dy)) ||
-                   (!maze.isWalkable(node.x - 1, node.y) && maze.isWalkable(node.x - 1, node.y + dy));
-        }
-        return false;
+    Cost heuristic(const Maze::Point& a, const Maze::Point& b) const {
+        return octileDistance<CostModel>(std::abs(a.x - b.x), std::abs(a.y - b.y));
     }
 
-    double heuristic(const Maze::Point& a, const Maze::Point& b) const {
-        double dx = std::abs(a.x - b.x);
-        double dy = std::abs(a.y - b.y);
-        return std::sqrt(2) * std::min(dx, dy) + std::abs(dx - dy);
+    // Exact for the straight and diagonal runs between jump points
+    Cost distance(const Maze::Point& a, const Maze::Point& b) const {
+        return octileDistance<CostModel>(std::abs(a.x - b.x), std::abs(a.y - b.y));
     }
+};
 
-    double distance(const Maze::Point& a, const Maze::Point& b) const {
-        double dx = a.x - b.x;
-        double dy = a.y - b.y;
-        return std::sqrt(dx * dx + dy * dy);
-    }
-}; 
\ No newline at end of file
+using JPS = BasicJPS<QuadHeap<double>>;
+
+// Integer JPS: 10/14 octile costs with ties broken towards the larger g
+class JPSOctile : public BasicJPS<QuadHeap<std::uint64_t>, OctileCost, PreferLargerG> {
+public:
+    JPSOctile() : BasicJPS("Jump Point Search (octile, integer)") {}
+};
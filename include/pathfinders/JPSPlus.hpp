@@ -0,0 +1,281 @@
+#pragma once
+
+#include "JPS.hpp"
+#include <cstring>
+#include <fstream>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define JUMP_TABLE_USE_MMAP 1
+#endif
+
+// Precomputed jumps for JPS+ (Rabin & Silva, "JPS+: An Extreme A*
+// Speed Optimization for Static Uniform Cost Grids"). For every cell and
+// each of the 8 directions (Maze::DIRECTION_DX/DY order) the table holds
+//
+//   d > 0   the next jump point is d steps away
+//   d <= 0  no jump point; -d steps are possible before the run hits a wall
+//
+// using the same forced-neighbour rules as BlockJumper, so a query is a
+// table lookup plus a check whether the goal lies inside the run. Runs
+// longer than a 16-bit entry can hold are split by treating the cell at the
+// limit as a jump point, which costs an extra expansion but never a wrong
+// path.
+//
+// Tables can be saved next to a maze file and reloaded with a read-only
+// memory mapping; the file stores the grid size and a fingerprint of the
+// walkable cells and is rejected when either no longer matches.
+class JumpTable {
+public:
+    static constexpr bool HAS_TABLES = true;
+
+    JumpTable() = default;
+    ~JumpTable() { unmap(); }
+    JumpTable(const JumpTable&) = delete;
+    JumpTable& operator=(const JumpTable&) = delete;
+
+    // Rebuild when the walls changed since the table was built or loaded
+    void update(const Maze& maze) {
+        if (stamp_ != maze.getWalkabilityStamp()) {
+            build(maze);
+        }
+    }
+
+    void build(const Maze& maze) {
+        unmap();
+        width_ = maze.getWidth();
+        height_ = maze.getHeight();
+        owned_.assign(static_cast<size_t>(width_) * height_ * Maze::DIRECTION_COUNT, 0);
+        table_ = owned_.data();
+
+        // Straight directions first: diagonal jump points depend on them
+        for (int d = 0; d < Maze::DIRECTION_COUNT; ++d) {
+            const int dx = Maze::DIRECTION_DX[d];
+            const int dy = Maze::DIRECTION_DY[d];
+
+            // Visit cells against the direction of travel so the next cell
+            // along the run is always finished first
+            for (int i = 0; i < height_; ++i) {
+                const int y = dy > 0 ? height_ - 1 - i : i;
+                for (int j = 0; j < width_; ++j) {
+                    const int x = dx > 0 ? width_ - 1 - j : j;
+                    if (!maze.isPassable(x, y)) continue;
+
+                    const int nx = x + dx;
+                    const int ny = y + dy;
+                    std::int16_t value;
+                    if (!maze.isPassable(nx, ny)) {
+                        value = 0;
+                    } else if (isJumpPoint(maze, nx, ny, dx, dy) ||
+                               (dx != 0 && dy != 0 &&
+                                (owned_[entry(maze.index(nx, ny), directionIndex(dx, 0))] > 0 ||
+                                 owned_[entry(maze.index(nx, ny), directionIndex(0, dy))] > 0))) {
+                        // Diagonal runs also stop where a straight run finds a jump point
+                        value = 1;
+                    } else {
+                        const std::int16_t next = owned_[entry(maze.index(nx, ny), d)];
+                        if (next >= LIMIT || next <= -LIMIT) {
+                            value = 1;  // split an over-long run
+                        } else {
+                            value = next > 0 ? next + 1 : next - 1;
+                        }
+                    }
+                    owned_[entry(maze.index(x, y), d)] = value;
+                }
+            }
+        }
+
+        stamp_ = maze.getWalkabilityStamp();
+    }
+
+    Maze::Point jump(const Maze& maze, const Maze::Point& node, int dx, int dy, const Maze::Point& goal) const {
+        const int distance = table_[entry(maze.index(node.x, node.y), directionIndex(dx, dy))];
+        const int reach = distance > 0 ? distance : -distance;
+
+        if (dx == 0 || dy == 0) {
+            // Goal on this line, ahead and within the run
+            const int toGoal = dx != 0 ? (goal.y == node.y ? (goal.x - node.x) * dx : -1)
+                                       : (goal.x == node.x ? (goal.y - node.y) * dy : -1);
+            if (toGoal > 0 && toGoal <= reach) return goal;
+        } else {
+            // Goal in this quadrant: stop on the diagonal where its row or
+            // column is reached, the straight run from there finds it
+            const int toGoalX = (goal.x - node.x) * dx;
+            const int toGoalY = (goal.y - node.y) * dy;
+            if (toGoalX > 0 && toGoalY > 0) {
+                const int steps = std::min(toGoalX, toGoalY);
+                if (steps <= reach) return Maze::Point(node.x + steps * dx, node.y + steps * dy);
+            }
+        }
+
+        if (distance <= 0) return Maze::Point(-1, -1);
+        return Maze::Point(node.x + distance * dx, node.y + distance * dy);
+    }
+
+    bool save(const Maze& maze, const std::string& mazePath) {
+        update(maze);
+
+        FileHeader header = makeHeader(maze);
+        std::ofstream file(tablePath(mazePath), std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(table_), tableBytes());
+        return static_cast<bool>(file);
+    }
+
+    bool load(const Maze& maze, const std::string& mazePath) {
+        const std::string path = tablePath(mazePath);
+        const FileHeader expected = makeHeader(maze);
+        const size_t dataBytes = static_cast<size_t>(maze.getWidth()) * maze.getHeight() *
+                                 Maze::DIRECTION_COUNT * sizeof(std::int16_t);
+        const size_t fileBytes = sizeof(FileHeader) + dataBytes;
+
+#ifdef JUMP_TABLE_USE_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) != fileBytes) {
+            ::close(fd);
+            return false;
+        }
+        void* mapping = ::mmap(nullptr, fileBytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED) return false;
+        if (std::memcmp(mapping, &expected, sizeof(FileHeader)) != 0) {
+            ::munmap(mapping, fileBytes);
+            return false;
+        }
+
+        unmap();
+        owned_.clear();
+        owned_.shrink_to_fit();
+        mapping_ = mapping;
+        mappedBytes_ = fileBytes;
+        table_ = reinterpret_cast<const std::int16_t*>(static_cast<const char*>(mapping) + sizeof(FileHeader));
+#else
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) return false;
+        FileHeader header;
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            std::memcmp(&header, &expected, sizeof(FileHeader)) != 0) {
+            return false;
+        }
+        std::vector<std::int16_t> table(dataBytes / sizeof(std::int16_t));
+        if (!file.read(reinterpret_cast<char*>(table.data()), dataBytes) || file.peek() != EOF) return false;
+        owned_.swap(table);
+        table_ = owned_.data();
+#endif
+
+        width_ = maze.getWidth();
+        height_ = maze.getHeight();
+        stamp_ = maze.getWalkabilityStamp();
+        return true;
+    }
+
+    bool isMapped() const { return mapping_ != nullptr; }
+
+    size_t memoryUsage() const {
+        return owned_.capacity() * sizeof(std::int16_t) + mappedBytes_;
+    }
+
+    static std::string tablePath(const std::string& mazePath) { return mazePath + ".jps"; }
+
+private:
+    static constexpr std::int16_t LIMIT = INT16_MAX;
+    static constexpr std::uint32_t FILE_VERSION = 1;
+
+    // Native byte order; the fingerprint guards against stale files
+    struct FileHeader {
+        char magic[4];
+        std::uint32_t version;
+        std::int32_t width;
+        std::int32_t height;
+        std::uint64_t fingerprint;
+    };
+
+    const std::int16_t* table_ = nullptr;
+    std::vector<std::int16_t> owned_;
+    void* mapping_ = nullptr;
+    size_t mappedBytes_ = 0;
+
+    // Walkability the table describes (Maze stamps start at 1)
+    std::uint64_t stamp_ = 0;
+    int width_ = 0;
+    int height_ = 0;
+
+    static size_t entry(int index, int direction) {
+        return static_cast<size_t>(index) * Maze::DIRECTION_COUNT + direction;
+    }
+
+    static int directionIndex(int dx, int dy) {
+        static constexpr int LOOKUP[3][3] = {
+            {7, 2, 6},   // dy = -1
+            {3, -1, 1},  // dy = 0
+            {5, 0, 4},   // dy = 1
+        };
+        return LOOKUP[dy + 1][dx + 1];
+    }
+
+    // Same stopping rules as BlockJumper, for a run arriving at (x, y)
+    static bool isJumpPoint(const Maze& maze, int x, int y, int dx, int dy) {
+        if (dx != 0 && dy != 0) {
+            return !maze.isPassable(x - dx, y) || !maze.isPassable(x, y - dy);
+        }
+        if (dx != 0) {
+            return (!maze.isPassable(x, y - 1) && maze.isPassable(x + dx, y - 1)) ||
+                   (!maze.isPassable(x, y + 1) && maze.isPassable(x + dx, y + 1));
+        }
+        return (!maze.isPassable(x - 1, y) && maze.isPassable(x - 1, y + dy)) ||
+               (!maze.isPassable(x + 1, y) && maze.isPassable(x + 1, y + dy));
+    }
+
+    size_t tableBytes() const {
+        return static_cast<size_t>(width_) * height_ * Maze::DIRECTION_COUNT * sizeof(std::int16_t);
+    }
+
+    // FNV-1a over the walkable cells, packed 8 to a byte
+    static FileHeader makeHeader(const Maze& maze) {
+        FileHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, "JPS+", 4);
+        header.version = FILE_VERSION;
+        header.width = maze.getWidth();
+        header.height = maze.getHeight();
+
+        std::uint64_t hash = 14695981039346656037ull;
+        std::uint8_t byte = 0;
+        int bits = 0;
+        for (int y = 0; y < maze.getHeight(); ++y) {
+            for (int x = 0; x < maze.getWidth(); ++x) {
+                byte = static_cast<std::uint8_t>((byte << 1) | maze.isPassable(x, y));
+                if (++bits == 8) {
+                    hash = (hash ^ byte) * 1099511628211ull;
+                    byte = 0;
+                    bits = 0;
+                }
+            }
+        }
+        header.fingerprint = (hash ^ byte) * 1099511628211ull;
+        return header;
+    }
+
+    void unmap() {
+#ifdef JUMP_TABLE_USE_MMAP
+        if (mapping_ != nullptr) {
+            ::munmap(mapping_, mappedBytes_);
+        }
+#endif
+        mapping_ = nullptr;
+        mappedBytes_ = 0;
+        table_ = owned_.data();
+    }
+};
+
+// JPS+: integer octile JPS whose jumps come from a JumpTable. The table is
+// built by prepare() or on the first query after the maze changes.
+class JPSPlus : public BasicJPS<QuadHeap<std::uint64_t>, OctileCost, PreferLargerG, JumpTable> {
+public:
+    JPSPlus() : BasicJPS("JPS+ (jump tables)") {}
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Maze.hpp"
+
+// Neighbourhood policies. The offsets are compile-time constants in the same
+// order as the bits of Maze::getNeighborMask(), so a search can restrict a
+// cell's mask with MASK and walk the remaining bits.
+
+// 4-directional movement
+struct FourNeighborhood {
+    static constexpr int COUNT = 4;
+    static constexpr int DX[COUNT] = {0, 1, 0, -1};  // down, right, up, left
+    static constexpr int DY[COUNT] = {1, 0, -1, 0};
+    static constexpr unsigned MASK = 0x0F;
+};
+
+// 8-directional movement (including diagonals)
+struct EightNeighborhood {
+    static constexpr int COUNT = 8;
+    static constexpr int DX[COUNT] = {0, 1, 0, -1, 1, -1, 1, -1};  // the four above, then
+    static constexpr int DY[COUNT] = {1, 0, -1, 0, 1, 1, -1, -1};  // down-right, down-left, up-right, up-left
+    static constexpr unsigned MASK = 0xFF;
+};
+
+template<typename Neighborhood>
+constexpr bool followsMazeDirections() {
+    for (int d = 0; d < Neighborhood::COUNT; ++d) {
+        if (Neighborhood::DX[d] != Maze::DIRECTION_DX[d] || Neighborhood::DY[d] != Maze::DIRECTION_DY[d]) return false;
+    }
+    return true;
+}
+
+static_assert(followsMazeDirections<FourNeighborhood>() && followsMazeDirections<EightNeighborhood>(),
+              "Neighbourhood offsets must follow the Maze neighbour mask bit order");
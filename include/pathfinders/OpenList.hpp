@@ -0,0 +1,623 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <type_traits>
+#include <algorithm>
+
+// Open lists for the best-first searches, keyed by Maze::index(x, y).
+//
+// Every open list keeps each cell at most once and exposes the same
+// interface, so the pathfinders can be instantiated with either of them:
+//
+//   reset(cellCount)         prepare for a new query, keeping allocations
+//   empty(), size()
+//   contains(index)          O(1) membership test
+//   push(index, key)         insert a cell that is not in the list
+//   decreaseKey(index, key)  lower the key of a cell that is in the list
+//   pushOrDecrease(index, key)
+//   top(), topKey()          cell with the smallest key
+//   pop()                    remove and return that cell
+//
+// FINAL_ON_DISCOVERY marks lists that are not ordered by key (FIFO / LIFO):
+// a cell pushed there is never improved later, so the search only pushes
+// undiscovered cells and decrease-key is not offered.
+
+// Implicit d-ary min-heap with a cell -> slot position map. A branching
+// factor of 4 keeps the tree shallow and the children of a node in one
+// cache line.
+template<typename Key, int Arity = 4>
+class IndexedDaryHeap {
+public:
+    static constexpr bool FINAL_ON_DISCOVERY = false;
+    static std::string name() { return std::to_string(Arity) + "-ary heap"; }
+
+    void reset(size_t cellCount) {
+        for (const Entry& entry : heap_) {
+            position_[entry.index] = NOT_IN_HEAP;
+        }
+        heap_.clear();
+        if (cellCount > position_.size()) {
+            position_.resize(cellCount, NOT_IN_HEAP);
+        }
+    }
+
+    bool empty() const { return heap_.empty(); }
+    size_t size() const { return heap_.size(); }
+    bool contains(int index) const { return position_[index] != NOT_IN_HEAP; }
+
+    void push(int index, Key key) {
+        heap_.push_back(Entry{key, index});
+        siftUp(heap_.size() - 1);
+    }
+
+    void decreaseKey(int index, Key key) {
+        size_t slot = position_[index];
+        heap_[slot].key = key;
+        siftUp(slot);
+    }
+
+    void pushOrDecrease(int index, Key key) {
+        if (contains(index)) {
+            decreaseKey(index, key);
+        } else {
+            push(index, key);
+        }
+    }
+
+    // Keys that may also grow, and removal from the middle, for incremental
+    // searches such as D* Lite; only this heap offers them
+    void update(int index, Key key) {
+        size_t slot = position_[index];
+        const bool lower = key < heap_[slot].key;
+        heap_[slot].key = key;
+        if (lower) {
+            siftUp(slot);
+        } else {
+            siftDown(slot);
+        }
+    }
+
+    void erase(int index) {
+        size_t slot = position_[index];
+        position_[index] = NOT_IN_HEAP;
+        Entry last = heap_.back();
+        heap_.pop_back();
+        if (slot < heap_.size()) {
+            place(slot, last);
+            siftUp(slot);
+            siftDown(position_[last.index]);
+        }
+    }
+
+    int top() const { return heap_.front().index; }
+    Key topKey() const { return heap_.front().key; }
+
+    int pop() {
+        int index = heap_.front().index;
+        position_[index] = NOT_IN_HEAP;
+        Entry last = heap_.back();
+        heap_.pop_back();
+        if (!heap_.empty()) {
+            heap_.front() = last;
+            siftDown(0);
+        }
+        return index;
+    }
+
+    size_t memoryUsage() const {
+        return heap_.capacity() * sizeof(Entry) + position_.capacity() * sizeof(int);
+    }
+
+private:
+    static constexpr int NOT_IN_HEAP = -1;
+
+    struct Entry {
+        Key key;
+        int index;
+    };
+
+    std::vector<Entry> heap_;
+    std::vector<int> position_;
+
+    void siftUp(size_t slot) {
+        Entry entry = heap_[slot];
+        while (slot > 0) {
+            size_t parent = (slot - 1) / Arity;
+            if (!(entry.key < heap_[parent].key)) break;
+            place(slot, heap_[parent]);
+            slot = parent;
+        }
+        place(slot, entry);
+    }
+
+    void siftDown(size_t slot) {
+        Entry entry = heap_[slot];
+        const size_t count = heap_.size();
+        while (true) {
+            size_t first = slot * Arity + 1;
+            if (first >= count) break;
+            size_t last = std::min(first + Arity, count);
+            size_t best = first;
+            for (size_t child = first + 1; child < last; ++child) {
+                if (heap_[child].key < heap_[best].key) best = child;
+            }
+            if (!(heap_[best].key < entry.key)) break;
+            place(slot, heap_[best]);
+            slot = best;
+        }
+        place(slot, entry);
+    }
+
+    void place(size_t slot, const Entry& entry) {
+        heap_[slot] = entry;
+        position_[entry.index] = static_cast<int>(slot);
+    }
+};
+
+template<typename Key>
+using QuadHeap = IndexedDaryHeap<Key, 4>;
+
+// Pairing heap with one preallocated node per cell. Insert and decrease-key
+// are O(1) melds; pop does the usual two-pass pairing of the root's children.
+template<typename Key>
+class PairingHeap {
+public:
+    static constexpr bool FINAL_ON_DISCOVERY = false;
+    static std::string name() { return "pairing heap"; }
+
+    void reset(size_t cellCount) {
+        if (cellCount > nodes_.size()) {
+            nodes_.resize(cellCount);
+            stamp_.assign(cellCount, 0);
+            generation_ = 0;
+        }
+        if (++generation_ == 0) {
+            std::fill(stamp_.begin(), stamp_.end(), 0);
+            generation_ = 1;
+        }
+        root_ = NONE;
+        size_ = 0;
+    }
+
+    bool empty() const { return root_ == NONE; }
+    size_t size() const { return size_; }
+    bool contains(int index) const { return stamp_[index] == generation_; }
+
+    void push(int index, Key key) {
+        Node& node = nodes_[index];
+        node.key = key;
+        node.child = node.sibling = node.prev = NONE;
+        stamp_[index] = generation_;
+        root_ = root_ == NONE ? index : meld(root_, index);
+        ++size_;
+    }
+
+    void decreaseKey(int index, Key key) {
+        nodes_[index].key = key;
+        if (index == root_) return;
+
+        // Cut the subtree out of its sibling list and meld it with the root
+        Node& node = nodes_[index];
+        if (nodes_[node.prev].child == index) {
+            nodes_[node.prev].child = node.sibling;
+        } else {
+            nodes_[node.prev].sibling = node.sibling;
+        }
+        if (node.sibling != NONE) nodes_[node.sibling].prev = node.prev;
+        node.sibling = node.prev = NONE;
+        root_ = meld(root_, index);
+    }
+
+    void pushOrDecrease(int index, Key key) {
+        if (contains(index)) {
+            decreaseKey(index, key);
+        } else {
+            push(index, key);
+        }
+    }
+
+    int top() const { return root_; }
+    Key topKey() const { return nodes_[root_].key; }
+
+    int pop() {
+        int index = root_;
+        stamp_[index] = 0;
+        --size_;
+        root_ = mergePairs(nodes_[index].child);
+        if (root_ != NONE) nodes_[root_].prev = NONE;
+        return index;
+    }
+
+    size_t memoryUsage() const {
+        return nodes_.capacity() * sizeof(Node) +
+               stamp_.capacity() * sizeof(std::uint32_t) +
+               pairs_.capacity() * sizeof(int);
+    }
+
+private:
+    static constexpr int NONE = -1;
+
+    struct Node {
+        Key key;
+        int child;    // leftmost child
+        int sibling;  // next sibling to the right
+        int prev;     // left sibling, or parent for a leftmost child
+    };
+
+    std::vector<Node> nodes_;
+    std::vector<std::uint32_t> stamp_;
+    std::vector<int> pairs_;
+    std::uint32_t generation_ = 0;
+    int root_ = NONE;
+    size_t size_ = 0;
+
+    // Link two roots; the larger key becomes the leftmost child of the smaller
+    int meld(int a, int b) {
+        if (nodes_[b].key < nodes_[a].key) std::swap(a, b);
+        Node& parent = nodes_[a];
+        Node& child = nodes_[b];
+        child.prev = a;
+        child.sibling = parent.child;
+        if (parent.child != NONE) nodes_[parent.child].prev = b;
+        parent.child = b;
+        parent.sibling = NONE;
+        return a;
+    }
+
+    int mergePairs(int first) {
+        if (first == NONE) return NONE;
+
+        // Left-to-right pass: meld neighbours pairwise
+        pairs_.clear();
+        while (first != NONE) {
+            int a = first;
+            int b = nodes_[a].sibling;
+            if (b == NONE) {
+                nodes_[a].prev = nodes_[a].sibling = NONE;
+                pairs_.push_back(a);
+                break;
+            }
+            first = nodes_[b].sibling;
+            nodes_[a].prev = nodes_[a].sibling = NONE;
+            nodes_[b].prev = nodes_[b].sibling = NONE;
+            pairs_.push_back(meld(a, b));
+        }
+
+        // Right-to-left pass: fold the pairs into a single tree
+        int root = pairs_.back();
+        for (size_t i = pairs_.size() - 1; i-- > 0;) {
+            root = meld(pairs_[i], root);
+        }
+        return root;
+    }
+};
+
+// Intrusive doubly-linked bucket lists over cell indices, shared by the
+// integer-keyed queues below. Every cell owns one link slot, so moving a cell
+// to another bucket (decrease-key) is O(1) and nothing is allocated per push.
+template<typename Key>
+class BucketLists {
+public:
+    static constexpr int NONE = -1;
+
+    void reset(size_t cellCount, size_t bucketCount) {
+        if (cellCount > key_.size()) {
+            key_.resize(cellCount);
+            next_.resize(cellCount);
+            prev_.resize(cellCount);
+            bucketOf_.resize(cellCount);
+            stamp_.assign(cellCount, 0);
+            generation_ = 0;
+        }
+        if (++generation_ == 0) {
+            std::fill(stamp_.begin(), stamp_.end(), 0);
+            generation_ = 1;
+        }
+        head_.assign(bucketCount, NONE);
+    }
+
+    bool contains(int index) const { return stamp_[index] == generation_; }
+    bool bucketEmpty(size_t bucket) const { return head_[bucket] == NONE; }
+    int head(size_t bucket) const { return head_[bucket]; }
+    int next(int index) const { return next_[index]; }
+    Key key(int index) const { return key_[index]; }
+    void setKey(int index, Key key) { key_[index] = key; }
+
+    void insert(int index, size_t bucket) {
+        stamp_[index] = generation_;
+        bucketOf_[index] = static_cast<int>(bucket);
+        prev_[index] = NONE;
+        next_[index] = head_[bucket];
+        if (head_[bucket] != NONE) prev_[head_[bucket]] = index;
+        head_[bucket] = index;
+    }
+
+    void unlink(int index) {
+        if (prev_[index] != NONE) {
+            next_[prev_[index]] = next_[index];
+        } else {
+            head_[bucketOf_[index]] = next_[index];
+        }
+        if (next_[index] != NONE) prev_[next_[index]] = prev_[index];
+        stamp_[index] = 0;
+    }
+
+    // Detach a whole bucket and return its first cell
+    int take(size_t bucket) {
+        int first = head_[bucket];
+        head_[bucket] = NONE;
+        return first;
+    }
+
+    size_t memoryUsage() const {
+        return key_.capacity() * sizeof(Key) +
+               (next_.capacity() + prev_.capacity() + bucketOf_.capacity() + head_.capacity()) * sizeof(int) +
+               stamp_.capacity() * sizeof(std::uint32_t);
+    }
+
+private:
+    std::vector<Key> key_;
+    std::vector<int> next_;
+    std::vector<int> prev_;
+    std::vector<int> bucketOf_;
+    std::vector<int> head_;
+    std::vector<std::uint32_t> stamp_;
+    std::uint32_t generation_ = 0;
+};
+
+// Dial's circular bucket queue for monotone integer keys whose open keys never
+// span more than MaxEdgeCost (true for Dijkstra with edge costs <= MaxEdgeCost).
+// Push, decrease-key and pop are all O(1) amortised.
+template<typename Key, int MaxEdgeCost>
+class BucketQueue {
+public:
+    static constexpr bool FINAL_ON_DISCOVERY = false;
+    static std::string name() { return "bucket queue"; }
+
+    void reset(size_t cellCount) {
+        lists_.reset(cellCount, BUCKETS);
+        cursor_ = 0;
+        size_ = 0;
+        started_ = false;
+    }
+
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+    bool contains(int index) const { return lists_.contains(index); }
+
+    void push(int index, Key key) {
+        // The first key of a query anchors the window; afterwards the cursor
+        // stays at the last popped key, which no later key can undercut
+        if (!started_) {
+            cursor_ = key;
+            started_ = true;
+        }
+        lists_.setKey(index, key);
+        lists_.insert(index, key & MASK);
+        ++size_;
+    }
+
+    void decreaseKey(int index, Key key) {
+        lists_.unlink(index);
+        lists_.setKey(index, key);
+        lists_.insert(index, key & MASK);
+    }
+
+    void pushOrDecrease(int index, Key key) {
+        if (contains(index)) {
+            decreaseKey(index, key);
+        } else {
+            push(index, key);
+        }
+    }
+
+    int top() { advance(); return lists_.head(cursor_ & MASK); }
+    Key topKey() { advance(); return cursor_; }
+
+    int pop() {
+        advance();
+        int index = lists_.head(cursor_ & MASK);
+        lists_.unlink(index);
+        --size_;
+        return index;
+    }
+
+    size_t memoryUsage() const { return lists_.memoryUsage(); }
+
+private:
+    // Smallest power of two above the widest possible key spread
+    static constexpr size_t bucketCount(size_t n) { return n <= 1 ? 1 : 2 * bucketCount((n + 1) / 2); }
+    static constexpr size_t BUCKETS = bucketCount(MaxEdgeCost + 1);
+    static constexpr Key MASK = static_cast<Key>(BUCKETS - 1);
+
+    BucketLists<Key> lists_;
+    Key cursor_ = 0;
+    size_t size_ = 0;
+    bool started_ = false;
+
+    void advance() {
+        while (lists_.bucketEmpty(cursor_ & MASK)) ++cursor_;
+    }
+};
+
+// Monotone radix heap (Ahuja, Mehlhorn, Orlin and Tarjan) with base-16 digits.
+// A key is filed under the most significant digit in which it differs from
+// the last key popped, so elements only ever move towards lower levels. With
+// octile costs of 10/14 every open key lies within 14 of that last key, so
+// keys usually land in the lowest levels, but a carry (last 0xFF, key 0x105)
+// can put one in any level; settle() therefore scans them all.
+template<typename Key>
+class RadixHeap {
+public:
+    static constexpr bool FINAL_ON_DISCOVERY = false;
+    static std::string name() { return "radix heap"; }
+
+    void reset(size_t cellCount) {
+        lists_.reset(cellCount, LEVELS * RADIX);
+        std::fill(std::begin(occupied_), std::end(occupied_), 0);
+        last_ = 0;
+        size_ = 0;
+    }
+
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+    bool contains(int index) const { return lists_.contains(index); }
+
+    void push(int index, Key key) {
+        lists_.setKey(index, key);
+        file(index);
+        ++size_;
+    }
+
+    void decreaseKey(int index, Key key) {
+        unfile(index);
+        lists_.setKey(index, key);
+        file(index);
+    }
+
+    void pushOrDecrease(int index, Key key) {
+        if (contains(index)) {
+            decreaseKey(index, key);
+        } else {
+            push(index, key);
+        }
+    }
+
+    int top() { settle(); return lists_.head(bucket(0, digit(last_, 0))); }
+    Key topKey() { settle(); return last_; }
+
+    int pop() {
+        settle();
+        int index = lists_.head(bucket(0, digit(last_, 0)));
+        unfile(index);
+        --size_;
+        return index;
+    }
+
+    size_t memoryUsage() const { return lists_.memoryUsage(); }
+
+private:
+    static constexpr int DIGIT_BITS = 4;
+    static constexpr int RADIX = 1 << DIGIT_BITS;
+    static constexpr int LEVELS = (sizeof(Key) * 8 + DIGIT_BITS - 1) / DIGIT_BITS;
+
+    BucketLists<Key> lists_;
+    std::uint32_t occupied_[LEVELS];  // bit j set when bucket (level, j) is non-empty
+    Key last_ = 0;
+    size_t size_ = 0;
+
+    static size_t bucket(int level, int value) { return level * RADIX + value; }
+    static int digit(Key key, int level) {
+        return static_cast<int>((static_cast<std::make_unsigned_t<Key>>(key) >> (level * DIGIT_BITS)) & (RADIX - 1));
+    }
+
+    int levelOf(Key key) const {
+        auto diff = static_cast<std::make_unsigned_t<Key>>(key ^ last_);
+        int level = 0;
+        while (diff >>= DIGIT_BITS) ++level;
+        return level;
+    }
+
+    void file(int index) {
+        Key key = lists_.key(index);
+        int level = levelOf(key);
+        int value = digit(key, level);
+        lists_.insert(index, bucket(level, value));
+        occupied_[level] |= 1u << value;
+    }
+
+    void unfile(int index) {
+        Key key = lists_.key(index);
+        int level = levelOf(key);
+        int value = digit(key, level);
+        lists_.unlink(index);
+        if (lists_.bucketEmpty(bucket(level, value))) occupied_[level] &= ~(1u << value);
+    }
+
+    // Make sure the minimum sits in the level-0 bucket of last_
+    void settle() {
+        if (occupied_[0] & (1u << digit(last_, 0))) return;
+
+        // Lowest non-empty bucket: lowest level first, then lowest digit
+        int level = 0;
+        while (occupied_[level] == 0) ++level;
+        int value = 0;
+        while (!(occupied_[level] & (1u << value))) ++value;
+
+        // Advance last_ to the minimum of that bucket and refile its cells,
+        // which all land on lower levels
+        occupied_[level] &= ~(1u << value);
+        int first = lists_.take(bucket(level, value));
+        Key minimum = lists_.key(first);
+        for (int i = first; i != BucketLists<Key>::NONE; i = lists_.next(i)) {
+            minimum = std::min(minimum, lists_.key(i));
+        }
+        last_ = minimum;
+        for (int i = first; i != BucketLists<Key>::NONE;) {
+            int next = lists_.next(i);
+            file(i);
+            i = next;
+        }
+    }
+};
+
+// First-in first-out list: expands cells in discovery order (BFS)
+template<typename Key>
+class FifoQueue {
+public:
+    static constexpr bool FINAL_ON_DISCOVERY = true;
+    static std::string name() { return "FIFO queue"; }
+
+    void reset(size_t /*cellCount*/) {
+        cells_.clear();
+        head_ = 0;
+    }
+
+    bool empty() const { return head_ == cells_.size(); }
+    size_t size() const { return cells_.size() - head_; }
+    void push(int index, Key /*key*/) { cells_.push_back(index); }
+    int pop() { return cells_[head_++]; }
+
+    size_t memoryUsage() const { return cells_.capacity() * sizeof(int); }
+
+private:
+    // Every cell is pushed at most once per query, so a plain vector with a
+    // moving head never needs to wrap around
+    std::vector<int> cells_;
+    size_t head_ = 0;
+};
+
+// Last-in first-out list: expands the most recently discovered cell (DFS)
+template<typename Key>
+class LifoStack {
+public:
+    static constexpr bool FINAL_ON_DISCOVERY = true;
+    static std::string name() { return "LIFO stack"; }
+
+    void reset(size_t /*cellCount*/) { cells_.clear(); }
+
+    bool empty() const { return cells_.empty(); }
+    size_t size() const { return cells_.size(); }
+    void push(int index, Key /*key*/) { cells_.push_back(index); }
+
+    int pop() {
+        int index = cells_.back();
+        cells_.pop_back();
+        return index;
+    }
+
+    size_t memoryUsage() const { return cells_.capacity() * sizeof(int); }
+
+private:
+    std::vector<int> cells_;
+};
+
+// Display name of a pathfinder instantiated with a given open list. The
+// default 4-ary heap keeps the plain name so existing reports stay stable.
+template<typename OpenList>
+std::string withOpenListName(const std::string& name) {
+    if (OpenList::name() == QuadHeap<int>::name()) return name;
+    return name + " [" + OpenList::name() + "]";
+}
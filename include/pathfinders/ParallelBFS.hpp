@@ -0,0 +1,311 @@
+#pragma once
+
+#include "Pathfinder.hpp"
+#include "Neighborhood.hpp"
+#include "Bits.hpp"
+#include <bits/stdc++.h>
+
+// Level-synchronous breadth-first search over 4-directional moves, spread
+// over several threads, with direction optimisation (Beamer, Asanovic &
+// Patterson, "Direction-Optimizing Breadth-First Search", SC 2012).
+//
+// Each level is expanded either top-down, with every frontier cell trying
+// to claim its unvisited neighbours through an atomic visited bitmap, or
+// bottom-up, with every unvisited cell looking for a neighbour in the
+// frontier bitmap and stopping at the first one. Top-down is cheaper while
+// the frontier is small; once it grows past a share of the cells still
+// unvisited, bottom-up avoids the failed claims. Threads pull blocks of
+// work from a shared cursor, fill private next-frontier buffers, and meet
+// at a barrier whose last arrival merges the buffers and picks the
+// direction of the next level.
+//
+// Levels are exact, so paths are as short as those of BFS, but which of
+// several equally short paths comes back depends on thread timing.
+class ParallelBFS : public Pathfinder {
+public:
+    // threads == 0 uses every hardware thread
+    explicit ParallelBFS(unsigned threads = 0) : threads_(threads) {}
+
+protected:
+    PathfindingResult search(const Maze& maze, const Maze::Point& start, const Maze::Point& goal,
+                             bool visualize, VisualizationCallback callback) override {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        PathfindingResult result;
+
+        if (!hasValidEndpoints(maze, start, goal) || !mayBeReachable(maze, start, goal)) return result;
+
+        const int startIndex = maze.index(start.x, start.y);
+        goal_ = maze.index(goal.x, goal.y);
+        reset(maze);
+
+        for (int d = 0; d < FourNeighborhood::COUNT; ++d) {
+            offsets_[d] = FourNeighborhood::DY[d] * maze.getWidth() + FourNeighborhood::DX[d];
+        }
+        visited_[startIndex >> 6].store(std::uint64_t(1) << (startIndex & 63), std::memory_order_relaxed);
+        parent_[startIndex] = -1;
+        frontier_.assign(1, startIndex);
+        frontierBits_[startIndex >> 6] |= std::uint64_t(1) << (startIndex & 63);
+        visitedCount_ = 1;
+        explored_ = 0;
+        bottomUpLevels_ = 0;
+        found_ = startIndex == goal_;
+        done_ = found_;
+        stoppedAt_ = -1;
+        visualize_ = visualize;
+        callback_ = callback;
+
+        // The calling thread is worker 0, and the only one when visualising
+        // so that the callback never runs elsewhere
+        unsigned workers = threads_ != 0 ? threads_ : std::max(1u, std::thread::hardware_concurrency());
+        workers = static_cast<unsigned>(std::min<size_t>(workers, std::max<size_t>(1, cellCount_ / MIN_CELLS_PER_THREAD)));
+        if (visualize) workers = 1;
+        workerCount_ = static_cast<int>(workers);
+        next_.resize(workers);
+        barrier_.reset(workerCount_);
+        std::vector<std::thread> threads;
+        for (unsigned t = 1; t < workers; ++t) {
+            threads.emplace_back([this, &maze, t] { run(maze, t); });
+        }
+        run(maze, 0);
+        for (std::thread& thread : threads) thread.join();
+
+        result.nodesExplored = explored_;
+        if (!found_ && stoppedAt_ >= 0) {
+            for (int cell = stoppedAt_; cell != -1; cell = parent_[cell]) {
+                result.path.push_back(maze.pointAt(cell));
+            }
+            std::reverse(result.path.begin(), result.path.end());
+        } else if (found_) {
+            for (int cell = goal_; cell != -1; cell = parent_[cell]) {
+                result.path.push_back(maze.pointAt(cell));
+            }
+            std::reverse(result.path.begin(), result.path.end());
+        }
+        result.pathLength = result.path.size();
+
+        // Calculate execution time
+        auto end_time = std::chrono::high_resolution_clock::now();
+        result.executionTime = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+
+        // Get memory usage
+        result.memoryUsage = getCurrentMemoryUsage() + parent_.capacity() * sizeof(int) +
+                             visitedWords_ * sizeof(std::uint64_t) * 2 + frontier_.capacity() * sizeof(int);
+        for (const std::vector<int>& next : next_) result.memoryUsage += next.capacity() * sizeof(int);
+
+        return result;
+    }
+
+public:
+    std::string getName() const override {
+        return "Parallel BFS (direction-optimizing)";
+    }
+
+    // Levels of the last query expanded bottom-up
+    size_t getBottomUpLevels() const { return bottomUpLevels_; }
+
+private:
+    // Grids smaller than this many cells per thread use fewer threads
+    static constexpr size_t MIN_CELLS_PER_THREAD = 1 << 14;
+
+    // Cells, or words of the visited bitmap, taken from the cursor at once
+    static constexpr size_t TOP_DOWN_BLOCK = 256;
+    static constexpr size_t BOTTOM_UP_BLOCK = 16;
+
+    // Beamer's switching thresholds: go bottom-up once the frontier exceeds
+    // 1/ALPHA of the unvisited cells, and back below 1/BETA of all cells.
+    // Cells stand in for edges, as every cell has at most four.
+    static constexpr size_t ALPHA = 14;
+    static constexpr size_t BETA = 24;
+
+    // Generation-counting barrier. The last thread to arrive runs the
+    // completion step before releasing the others; waiting threads spin
+    // and yield, since levels are short.
+    class LevelBarrier {
+    public:
+        void reset(int count) {
+            count_ = count;
+            waiting_.store(0, std::memory_order_relaxed);
+        }
+
+        template<typename Completion>
+        void arriveAndWait(Completion&& completion) {
+            const unsigned generation = generation_.load(std::memory_order_acquire);
+            if (waiting_.fetch_add(1, std::memory_order_acq_rel) + 1 == count_) {
+                completion();
+                waiting_.store(0, std::memory_order_relaxed);
+                generation_.fetch_add(1, std::memory_order_release);
+                return;
+            }
+            while (generation_.load(std::memory_order_acquire) == generation) {
+                std::this_thread::yield();
+            }
+        }
+
+    private:
+        int count_ = 1;
+        std::atomic<int> waiting_{0};
+        std::atomic<unsigned> generation_{0};
+    };
+
+    unsigned threads_;
+    int workerCount_ = 1;
+    size_t cellCount_ = 0;
+    size_t visitedWords_ = 0;
+    int goal_ = -1;
+    int offsets_[FourNeighborhood::COUNT] = {};
+
+    std::unique_ptr<std::atomic<std::uint64_t>[]> visited_;
+    std::vector<std::uint64_t> frontierBits_;
+    std::vector<int> parent_;
+    std::vector<int> frontier_;
+    std::vector<std::vector<int>> next_;  // per worker
+    LevelBarrier barrier_;
+    std::atomic<size_t> cursor_{0};
+
+    // Written only by the barrier completion, read by all workers after it
+    bool bottomUp_ = false;
+    bool done_ = false;
+    bool found_ = false;
+    size_t visitedCount_ = 0;
+    size_t explored_ = 0;
+    size_t bottomUpLevels_ = 0;
+    int stoppedAt_ = -1;  // frontier cell closest to the goal when the limits stopped the search
+    bool visualize_ = false;
+    VisualizationCallback callback_;
+
+    void reset(const Maze& maze) {
+        const size_t cellCount = static_cast<size_t>(maze.getWidth()) * maze.getHeight();
+        const size_t words = (cellCount + 63) / 64;
+        if (words != visitedWords_) {
+            visited_.reset(new std::atomic<std::uint64_t>[words]);
+            visitedWords_ = words;
+        }
+        for (size_t w = 0; w < words; ++w) visited_[w].store(0, std::memory_order_relaxed);
+        frontierBits_.assign(words, 0);
+        parent_.resize(cellCount);
+        cellCount_ = cellCount;
+        bottomUp_ = false;
+        cursor_.store(0, std::memory_order_relaxed);
+    }
+
+    bool isVisited(int cell) const {
+        return (visited_[cell >> 6].load(std::memory_order_relaxed) >> (cell & 63)) & 1;
+    }
+
+    void run(const Maze& maze, unsigned worker) {
+        std::vector<int>& next = next_[worker];
+        while (!done_) {
+            next.clear();
+            if (bottomUp_) {
+                expandBottomUp(maze, next);
+            } else {
+                expandTopDown(maze, next);
+            }
+            barrier_.arriveAndWait([&] { finishLevel(maze); });
+        }
+    }
+
+    // Frontier cells claim their unvisited neighbours
+    void expandTopDown(const Maze& maze, std::vector<int>& next) {
+        const size_t size = frontier_.size();
+        for (size_t begin = cursor_.fetch_add(TOP_DOWN_BLOCK, std::memory_order_relaxed); begin < size;
+             begin = cursor_.fetch_add(TOP_DOWN_BLOCK, std::memory_order_relaxed)) {
+            const size_t end = std::min(begin + TOP_DOWN_BLOCK, size);
+            for (size_t i = begin; i < end; ++i) {
+                const int cell = frontier_[i];
+                unsigned mask = maze.getNeighborMask(cell) & FourNeighborhood::MASK;
+                for (; mask != 0; mask &= mask - 1) {
+                    const int neighbor = cell + offsets_[countTrailingZeros(static_cast<std::uint32_t>(mask))];
+                    const std::uint64_t bit = std::uint64_t(1) << (neighbor & 63);
+                    std::atomic<std::uint64_t>& word = visited_[neighbor >> 6];
+                    if (word.load(std::memory_order_relaxed) & bit) continue;
+                    if (word.fetch_or(bit, std::memory_order_relaxed) & bit) continue;
+                    parent_[neighbor] = cell;
+                    next.push_back(neighbor);
+                }
+            }
+        }
+    }
+
+    // Unvisited cells look for a parent in the frontier. Each block of
+    // visited words belongs to one worker, so its bits are set in one store.
+    void expandBottomUp(const Maze& maze, std::vector<int>& next) {
+        const Maze::CellType* terrain = maze.terrainData();
+        for (size_t begin = cursor_.fetch_add(BOTTOM_UP_BLOCK, std::memory_order_relaxed); begin < visitedWords_;
+             begin = cursor_.fetch_add(BOTTOM_UP_BLOCK, std::memory_order_relaxed)) {
+            const size_t end = std::min(begin + BOTTOM_UP_BLOCK, visitedWords_);
+            for (size_t w = begin; w < end; ++w) {
+                const std::uint64_t seen = visited_[w].load(std::memory_order_relaxed);
+                std::uint64_t claimed = 0;
+                for (std::uint64_t open = ~seen; open != 0; open &= open - 1) {
+                    const int cell = static_cast<int>(w * 64) + countTrailingZeros(open);
+                    if (static_cast<size_t>(cell) >= cellCount_) break;
+                    if (terrain[cell] == Maze::CellType::WALL) continue;
+                    unsigned mask = maze.getNeighborMask(cell) & FourNeighborhood::MASK;
+                    for (; mask != 0; mask &= mask - 1) {
+                        const int neighbor = cell + offsets_[countTrailingZeros(static_cast<std::uint32_t>(mask))];
+                        if ((frontierBits_[neighbor >> 6] >> (neighbor & 63)) & 1) {
+                            parent_[cell] = neighbor;
+                            claimed |= std::uint64_t(1) << (cell & 63);
+                            next.push_back(cell);
+                            break;
+                        }
+                    }
+                }
+                if (claimed != 0) visited_[w].store(seen | claimed, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    int closestToGoal(const Maze& maze) const {
+        const Maze::Point goal = maze.pointAt(goal_);
+        int best = -1;
+        int bestDistance = std::numeric_limits<int>::max();
+        for (int cell : frontier_) {
+            const Maze::Point p = maze.pointAt(cell);
+            const int distance = std::abs(p.x - goal.x) + std::abs(p.y - goal.y);
+            if (distance < bestDistance) {
+                bestDistance = distance;
+                best = cell;
+            }
+        }
+        return best;
+    }
+
+    // Runs on one thread between levels: merges the next frontiers, stops
+    // at the goal, when nothing is left or at the query limits, and picks
+    // the next direction
+    void finishLevel(const Maze& maze) {
+        explored_ += frontier_.size();
+        for (int cell : frontier_) frontierBits_[cell >> 6] = 0;
+        frontier_.clear();
+        for (int t = 0; t < workerCount_; ++t) {
+            frontier_.insert(frontier_.end(), next_[t].begin(), next_[t].end());
+        }
+        for (int cell : frontier_) frontierBits_[cell >> 6] |= std::uint64_t(1) << (cell & 63);
+        visitedCount_ += frontier_.size();
+        if (bottomUp_) ++bottomUpLevels_;
+
+        if (visualize_ || getTrace()) {
+            for (int cell : frontier_) {
+                traceExpansion(cell);
+                visualizeStep(maze.pointAt(cell), {}, visualize_, callback_);
+            }
+        }
+
+        found_ = isVisited(goal_);
+        done_ = found_ || frontier_.empty();
+        if (!done_ && limitReached(explored_)) {
+            done_ = true;
+            stoppedAt_ = closestToGoal(maze);
+        }
+
+        const size_t unvisited = cellCount_ - visitedCount_;
+        if (!bottomUp_ && frontier_.size() * ALPHA > unvisited) {
+            bottomUp_ = true;
+        } else if (bottomUp_ && frontier_.size() * BETA < cellCount_) {
+            bottomUp_ = false;
+        }
+        cursor_.store(0, std::memory_order_relaxed);
+    }
+};
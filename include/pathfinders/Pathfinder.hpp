@@ -1,6 +1,9 @@
 #pragma once
 
 #include "../Maze.hpp"
+#include "SearchState.hpp"
+#include "CostModel.hpp"
+#include "SearchTrace.hpp"
 #include <vector>
 #include <chrono>
 #include <string>
@@ -8,97 +11,215 @@
 #include <bits/stdc++.h>
 #include <functional>
 #include <thread>
+#include <atomic>
 
 class Pathfinder {
 public:
     // Add callback type for visualization
     using VisualizationCallback = std::function<void(const Maze::Point&, const std::vector<Maze::Point>&)>;
     
+    // How a query ended. A search stopped by one of its limits returns the
+    // route to the expanded cell closest to the goal, where it has one; an
+    // anytime search stopped after reaching the goal still counts as FOUND.
+    enum class SearchStatus {
+        FOUND,
+        NO_PATH,
+        EXHAUSTED,  // node budget used up
+        TIMED_OUT,
+        CANCELLED
+    };
+
+    // Set from any thread to stop the queries that share it. A token made
+    // with a parent also reads as cancelled while the parent is.
+    class CancellationToken {
+    public:
+        CancellationToken() = default;
+        explicit CancellationToken(std::shared_ptr<const CancellationToken> parent) : parent_(std::move(parent)) {}
+
+        void cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+        void reset() { cancelled_.store(false, std::memory_order_relaxed); }
+        bool isCancelled() const {
+            return cancelled_.load(std::memory_order_relaxed) || (parent_ && parent_->isCancelled());
+        }
+
+    private:
+        std::atomic<bool> cancelled_{false};
+        std::shared_ptr<const CancellationToken> parent_;
+    };
+
+    // Per-query limits; a zero / null member means no limit of that kind
+    struct SearchLimits {
+        double timeBudgetMs = 0;
+        size_t maxNodes = 0;
+        std::shared_ptr<const CancellationToken> cancellation;
+    };
+
+    // One path found by an anytime search on its way to the final answer
+    struct Improvement {
+        double elapsed = 0;        // since the query started, in milliseconds
+        double bound = 1;          // cost is at most bound times the optimum
+        double cost = 0;           // 1 per straight step, 1.4 per diagonal
+        size_t pathLength = 0;
+    };
+
     struct PathfindingResult {
         std::vector<Maze::Point> path;
-        double executionTime;  // in milliseconds
-        size_t nodesExplored;
-        size_t pathLength;
-        size_t memoryUsage;    // in bytes
+        double executionTime = 0;  // in milliseconds
+        size_t nodesExplored = 0;
+        size_t pathLength = 0;
+        size_t memoryUsage = 0;    // in bytes
+
+        // Anytime searches return their best path so far together with its
+        // suboptimality bound, and every improvement in the order found.
+        // Exact searches leave the bound at 1 and the history empty.
+        double suboptimalityBound = 1;
+        std::vector<Improvement> improvements;
+
+        SearchStatus status = SearchStatus::NO_PATH;
     };
 
     virtual ~Pathfinder() = default;
 
-    // Main solving method that all algorithms must implement
-    virtual PathfindingResult findPath(const Maze& maze, bool visualize = false, VisualizationCallback callback = nullptr) = 0;
+    // Query between the maze's own start and goal
+    PathfindingResult findPath(const Maze& maze, bool visualize = false, VisualizationCallback callback = nullptr) {
+        return findPath(maze, maze.getStart(), maze.getGoal(), visualize, callback);
+    }
+
+    // Query between explicit endpoints, for serving many queries against one
+    // maze without editing it. Searches only read the maze, so one maze may
+    // be shared by several Pathfinder objects running concurrently; each
+    // Pathfinder reuses its own workspace and runs one query at a time.
+    PathfindingResult findPath(const Maze& maze, const Maze::Point& start, const Maze::Point& goal,
+                               bool visualize = false, VisualizationCallback callback = nullptr) {
+        beginQuery(goal);
+        if (trace_) trace_->begin(maze, start, goal, getName());
+        PathfindingResult result = search(maze, start, goal, visualize, callback);
+        if (stopped_ && (result.path.empty() || result.path.back() != goal)) {
+            result.status = stopStatus_;
+        } else {
+            result.status = result.path.empty() ? SearchStatus::NO_PATH : SearchStatus::FOUND;
+        }
+        return result;
+    }
+
+    // Limits applied to every following query of this pathfinder
+    void setLimits(const SearchLimits& limits) { limits_ = limits; }
+    const SearchLimits& getLimits() const { return limits_; }
+
+    // Trace recording every following query of this pathfinder, or null.
+    // The trace must outlive the queries it records.
+    void setTrace(SearchTrace* trace) { trace_ = trace; }
+    SearchTrace* getTrace() const { return trace_; }
 
     // Get algorithm name for display and benchmarking
     virtual std::string getName() const = 0;
 
-    // Optional method to visualize the search process
+    // Optional per-map preprocessing (jump tables, abstractions, ...).
+    // prepare() builds it ahead of a run of queries against an unchanged
+    // maze; findPath() must still work, rebuilding on demand, without it.
+    virtual void prepare(const Maze& /*maze*/) {}
+
+    // Makes this instance search with the preprocessing another instance of
+    // the same algorithm built, instead of building its own. Read-only
+    // tables are shared, not copied; while they are, a prepare() on one
+    // instance must not overlap a search on another. Returns false when the
+    // algorithm has nothing to share or `source` is a different algorithm.
+    virtual bool sharePreprocessing(const Pathfinder& /*source*/) { return false; }
+
+    // Store / restore the preprocessing next to the maze file it was built
+    // for. Both return false when the algorithm has nothing to persist or
+    // the stored data does not match the maze.
+    virtual bool savePreprocessing(const Maze& /*maze*/, const std::string& /*mazePath*/) { return false; }
+    virtual bool loadPreprocessing(const Maze& /*maze*/, const std::string& /*mazePath*/) { return false; }
+
+    // Reports one step of the search process. Pacing is up to the callback:
+    // SteppedSearch parks the search here until its owner asks for more.
     virtual void visualizeStep(const Maze::Point& current, const std::vector<Maze::Point>& path, 
                               bool visualize, VisualizationCallback callback) {
         if (visualize && callback) {
             callback(current, path);
-            std::this_thread::sleep_for(std::chrono::milliseconds(50)); // Delay for visualization
         }
     }
 
 protected:
-    // Helper method to reconstruct path from came_from map
-    template<typename CameFromMap>
+    // Helper method to reconstruct path by following parent links back to the start
+    template<typename Cost>
     std::vector<Maze::Point> reconstructPath(
-        const CameFromMap& cameFrom,
-        const Maze::Point& start,
-        const Maze::Point& current) const {
+        const BasicSearchState<Cost>& state,
+        const Maze& maze,
+        int current) const {
         
         std::vector<Maze::Point> path;
-        Maze::Point current_node = current;
-        
-        while (current_node != start) {
-            path.push_back(current_node);
-            auto it = cameFrom.find(current_node);
-            if (it == cameFrom.end()) break;
-            current_node = it->second;
+        for (int node = current; node != BasicSearchState<Cost>::NO_PARENT; node = state.parent(node)) {
+            path.push_back(maze.pointAt(node));
         }
-        path.push_back(start);
         
         std::reverse(path.begin(), path.end());
         return path;
     }
 
-    // Common neighbor directions (4-directional)
-    const std::vector<std::pair<int, int>> directions4 = {
-        {0, 1},  // down
-        {1, 0},  // right
-        {0, -1}, // up
-        {-1, 0}  // left
-    };
+    // Main solving method that all algorithms must implement
+    virtual PathfindingResult search(const Maze& maze, const Maze::Point& start, const Maze::Point& goal,
+                                     bool visualize, VisualizationCallback callback) = 0;
 
-    // 8-directional movement (including diagonals)
-    const std::vector<std::pair<int, int>> directions8 = {
-        {0, 1},   // down
-        {1, 0},   // right
-        {0, -1},  // up
-        {-1, 0},  // left
-        {1, 1},   // down-right
-        {-1, 1},  // down-left
-        {1, -1},  // up-right
-        {-1, -1}  // up-left
-    };
+    // Guard used before indexing per-cell state with the query endpoints
+    bool hasValidEndpoints(const Maze& maze, const Maze::Point& start, const Maze::Point& goal) const {
+        return maze.isValidCell(start.x, start.y) && maze.isValidCell(goal.x, goal.y);
+    }
 
-    // Helper method to get valid neighbors
-    std::vector<Maze::Point> getNeighbors(
-        const Maze& maze,
-        const Maze::Point& current,
-        bool allowDiagonal = false) const {
-        
-        std::vector<Maze::Point> neighbors;
-        const auto& dirs = allowDiagonal ? directions8 : directions4;
-
-        for (const auto& [dx, dy] : dirs) {
-            Maze::Point next(current.x + dx, current.y + dy);
-            if (maze.isValidCell(next.x, next.y) && maze.isWalkable(next.x, next.y)) {
-                neighbors.push_back(next);
-            }
+    // Endpoints in different components of the maze can never be joined,
+    // which the maze answers without searching. The components allow
+    // diagonal moves, so this is also safe for four-way searches.
+    bool mayBeReachable(const Maze& maze, const Maze::Point& start, const Maze::Point& goal) const {
+        return maze.areConnected(start, goal);
+    }
+
+    // True once the running query has hit one of its limits, and from then
+    // on. Searches call it once per expansion, or once per batch of them,
+    // with the expansions so far: the node budget is a compare, while the
+    // clock and the token are only read every LIMIT_CHECK_INTERVAL
+    // expansions, so limits can stay on.
+    bool limitReached(size_t nodesExplored) {
+        if (!limited_) return false;
+        if (stopped_) return true;
+        if (limits_.maxNodes != 0 && nodesExplored >= limits_.maxNodes) return stop(SearchStatus::EXHAUSTED);
+        if (nodesExplored < nextLimitCheck_) return false;
+        nextLimitCheck_ = nodesExplored + LIMIT_CHECK_INTERVAL;
+        if (limits_.cancellation && limits_.cancellation->isCancelled()) return stop(SearchStatus::CANCELLED);
+        if (limits_.timeBudgetMs > 0 && std::chrono::steady_clock::now() >= deadline_) return stop(SearchStatus::TIMED_OUT);
+        return false;
+    }
+
+    // Trace hooks, one per expansion and one per parent change, costing a
+    // predictable branch when nothing is recording
+    void traceExpansion(int cell) {
+        if (trace_) trace_->expansion(cell);
+    }
+    void traceParent(int cell, int parent) {
+        if (trace_) trace_->parent(cell, parent);
+    }
+
+    // Whether limitReached() stopped the running query
+    bool limitStopped() const { return stopped_; }
+
+    // Keeps the expanded cell closest to the goal while the query has
+    // limits, one compare per expansion, so a stopped search can return the
+    // route to it without scanning the grid. Searches call it for every
+    // expansion on the side whose parents partialPath() follows.
+    void noteExpansion(const Maze& maze, int cell) {
+        if (!limited_) return;
+        const Maze::Point p = maze.pointAt(cell);
+        const int distance = octileDistance<OctileCost>(std::abs(p.x - goal_.x), std::abs(p.y - goal_.y));
+        if (distance < closestDistance_) {
+            closestDistance_ = distance;
+            closestCell_ = cell;
         }
+    }
 
-        return neighbors;
+    // Route to the expanded cell closest to the goal, for a stopped search
+    template<typename Cost>
+    std::vector<Maze::Point> partialPath(const BasicSearchState<Cost>& state, const Maze& maze) const {
+        return closestCell_ < 0 ? std::vector<Maze::Point>() : reconstructPath(state, maze, closestCell_);
     }
 
     // Helper method to measure memory usage
@@ -107,4 +228,38 @@ protected:
         // you would use platform-specific methods to get actual memory usage
         return 0;
     }
+
+private:
+    static constexpr size_t LIMIT_CHECK_INTERVAL = 256;
+
+    SearchLimits limits_;
+    SearchTrace* trace_ = nullptr;
+    bool limited_ = false;
+    bool stopped_ = false;
+    SearchStatus stopStatus_ = SearchStatus::NO_PATH;
+    size_t nextLimitCheck_ = 0;
+    std::chrono::steady_clock::time_point deadline_;
+    Maze::Point goal_;
+    int closestCell_ = -1;
+    int closestDistance_ = 0;
+
+    void beginQuery(const Maze::Point& goal) {
+        limited_ = limits_.timeBudgetMs > 0 || limits_.maxNodes != 0 || limits_.cancellation;
+        stopped_ = false;
+        nextLimitCheck_ = 0;
+        goal_ = goal;
+        closestCell_ = -1;
+        closestDistance_ = std::numeric_limits<int>::max();
+        if (limits_.timeBudgetMs > 0) {
+            deadline_ = std::chrono::steady_clock::now() +
+                        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                            std::chrono::duration<double, std::milli>(limits_.timeBudgetMs));
+        }
+    }
+
+    bool stop(SearchStatus status) {
+        stopped_ = true;
+        stopStatus_ = status;
+        return true;
+    }
 }; 
\ No newline at end of file
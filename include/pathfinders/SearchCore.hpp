@@ -0,0 +1,135 @@
+#pragma once
+
+#include "Pathfinder.hpp"
+#include "OpenList.hpp"
+#include "CostModel.hpp"
+#include "Heuristic.hpp"
+#include "Neighborhood.hpp"
+#include "Bits.hpp"
+#include <bits/stdc++.h>
+
+// Generic best-first grid search, specialised at compile time.
+//
+//   Neighborhood  offsets to expand (FourNeighborhood / EightNeighborhood)
+//   Heuristic     goal estimate added to the priority (ZeroHeuristic gives
+//                 Dijkstra/BFS behaviour)
+//   CostModel     step costs and the cost type used for g, f and the keys
+//   OpenList      priority structure from OpenList.hpp
+//   TieBreak      maps f and g to the open-list key (see Heuristic.hpp); the
+//                 open list's key type must match what it returns
+//
+// Everything the inner loop touches is a template parameter or a member
+// reused across queries. An expansion loads the cell's precomputed
+// neighbour mask from the maze and walks its set bits, adding a per-query
+// index offset for each, so there are no bounds checks, no virtual calls and
+// no allocation. The classic
+// algorithms (A*, Dijkstra, BFS, DFS, greedy best-first) are thin
+// instantiations of this class.
+template<typename Neighborhood, typename Heuristic, typename CostModel, typename OpenList,
+         typename TieBreak = NoTieBreak>
+class BestFirstSearch : public Pathfinder {
+public:
+    using Cost = typename CostModel::Cost;
+
+    explicit BestFirstSearch(std::string name) : name_(std::move(name)) {}
+
+protected:
+    PathfindingResult search(const Maze& maze, const Maze::Point& start, const Maze::Point& goal,
+                             bool visualize, VisualizationCallback callback) override {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        PathfindingResult result;
+        result.nodesExplored = 0;
+
+        if (!hasValidEndpoints(maze, start, goal) || !mayBeReachable(maze, start, goal)) return result;
+
+        const int startIndex = maze.index(start.x, start.y);
+        const int goalIndex = maze.index(goal.x, goal.y);
+
+        // Open list and dense per-cell tracking, reused across queries
+        const size_t cellCount = maze.getWidth() * maze.getHeight();
+        open_.reset(cellCount);
+        state_.reset(cellCount);
+
+        // Neighbour offsets in flat index space for this grid width
+        int offsets[Neighborhood::COUNT];
+        for (int d = 0; d < Neighborhood::COUNT; ++d) {
+            offsets[d] = Neighborhood::DY[d] * maze.getWidth() + Neighborhood::DX[d];
+        }
+
+        open_.push(startIndex, TieBreak::key(estimate(start, goal), Cost(0)));
+        state_.open(startIndex, Cost(0), BasicSearchState<Cost>::NO_PARENT);
+
+        while (!open_.empty()) {
+            if (limitReached(result.nodesExplored)) {
+                result.path = partialPath(state_, maze);
+                result.pathLength = result.path.size();
+                break;
+            }
+
+            const int currentIndex = open_.pop();
+            const Maze::Point current = maze.pointAt(currentIndex);
+            const Cost currentG = state_.cost(currentIndex);
+            state_.close(currentIndex);
+            result.nodesExplored++;
+            traceExpansion(currentIndex);
+            noteExpansion(maze, currentIndex);
+
+            // Visualize current step
+            if (visualize) {
+                std::vector<Maze::Point> currentPath = reconstructPath(state_, maze, currentIndex);
+                visualizeStep(current, currentPath, visualize, callback);
+            }
+
+            // Found the goal
+            if (currentIndex == goalIndex) {
+                result.path = reconstructPath(state_, maze, goalIndex);
+                result.pathLength = result.path.size();
+                break;
+            }
+
+            // One byte load gives every walkable neighbour
+            unsigned mask = maze.getNeighborMask(currentIndex) & Neighborhood::MASK;
+            for (; mask != 0; mask &= mask - 1) {
+                const int d = countTrailingZeros(static_cast<std::uint32_t>(mask));
+                const int neighborIndex = currentIndex + offsets[d];
+                const Cost tentativeG = currentG + CostModel::step(Neighborhood::DX[d], Neighborhood::DY[d]);
+
+                if constexpr (OpenList::FINAL_ON_DISCOVERY) {
+                    if (state_.visited(neighborIndex)) continue;
+                    state_.open(neighborIndex, tentativeG, currentIndex);
+                    traceParent(neighborIndex, currentIndex);
+                    open_.push(neighborIndex, tentativeG);
+                } else if (!state_.visited(neighborIndex) || tentativeG < state_.cost(neighborIndex)) {
+                    state_.open(neighborIndex, tentativeG, currentIndex);
+                    state_.reopen(neighborIndex);
+                    traceParent(neighborIndex, currentIndex);
+                    const Cost h = estimate(Maze::Point(current.x + Neighborhood::DX[d], current.y + Neighborhood::DY[d]), goal);
+                    open_.pushOrDecrease(neighborIndex, TieBreak::key(tentativeG + h, tentativeG));
+                }
+            }
+        }
+
+        // Calculate execution time
+        auto end_time = std::chrono::high_resolution_clock::now();
+        result.executionTime = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+
+        // Get memory usage
+        result.memoryUsage = getCurrentMemoryUsage() + state_.memoryUsage() + open_.memoryUsage();
+
+        return result;
+    }
+
+public:
+    std::string getName() const override {
+        return name_;
+    }
+
+private:
+    std::string name_;
+    BasicSearchState<Cost> state_;
+    OpenList open_;
+
+    Cost estimate(const Maze::Point& from, const Maze::Point& goal) const {
+        return Heuristic::template estimate<Cost>(std::abs(from.x - goal.x), std::abs(from.y - goal.y));
+    }
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "../Maze.hpp"
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+
+// Dense per-cell search bookkeeping indexed by Maze::index(x, y).
+//
+// Parent, g-cost and closed flags live in flat arrays that are kept between
+// queries. Instead of clearing them, every reset() starts a new generation:
+// an entry only counts as set when its stamp matches the current generation,
+// so repeated searches on the same maze never touch memory they don't use.
+template<typename Cost>
+class BasicSearchState {
+public:
+    static constexpr int NO_PARENT = -1;
+
+    // Prepare for a new query on a grid with the given number of cells
+    void reset(size_t cellCount) {
+        if (cellCount > seenStamp_.size()) {
+            seenStamp_.assign(cellCount, 0);
+            closedStamp_.assign(cellCount, 0);
+            parent_.resize(cellCount);
+            cost_.resize(cellCount);
+            generation_ = 0;
+        }
+        if (++generation_ == 0) {
+            // Stamp wrap-around: the only time the arrays are cleared
+            std::fill(seenStamp_.begin(), seenStamp_.end(), 0);
+            std::fill(closedStamp_.begin(), closedStamp_.end(), 0);
+            generation_ = 1;
+        }
+    }
+
+    // Has the cell been reached during the current query?
+    bool visited(int index) const { return seenStamp_[index] == generation_; }
+
+    // Record (or improve) the cost and parent of a cell
+    void open(int index, Cost cost, int parent) {
+        seenStamp_[index] = generation_;
+        cost_[index] = cost;
+        parent_[index] = parent;
+    }
+
+    Cost cost(int index) const {
+        return visited(index) ? cost_[index] : std::numeric_limits<Cost>::max();
+    }
+    int parent(int index) const { return parent_[index]; }
+
+    bool closed(int index) const { return closedStamp_[index] == generation_; }
+    void close(int index) { closedStamp_[index] = generation_; }
+    void reopen(int index) { closedStamp_[index] = 0; }
+
+    size_t memoryUsage() const {
+        return seenStamp_.capacity() * sizeof(std::uint32_t) +
+               closedStamp_.capacity() * sizeof(std::uint32_t) +
+               parent_.capacity() * sizeof(int) +
+               cost_.capacity() * sizeof(Cost);
+    }
+
+private:
+    std::vector<std::uint32_t> seenStamp_;
+    std::vector<std::uint32_t> closedStamp_;
+    std::vector<int> parent_;
+    std::vector<Cost> cost_;
+    std::uint32_t generation_ = 0;
+};
+
+using SearchState = BasicSearchState<double>;
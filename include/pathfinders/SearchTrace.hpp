@@ -0,0 +1,155 @@
+#pragma once
+
+#include "../Maze.hpp"
+#include <bits/stdc++.h>
+
+// Record of one query as it ran: every expansion and every parent change,
+// eight bytes each, in a ring buffer allocated up front. Recording is a
+// store and an increment, so a traced search runs at full speed; when the
+// buffer wraps, the oldest events give way and are counted as dropped.
+//
+// Parent changes are enough to rebuild the search tree at any point of the
+// run, so paths are only worked out when a replay (TraceReplay.hpp) asks
+// for one. Traces can be saved and loaded to compare runs afterwards.
+class SearchTrace {
+public:
+    // A parent change of `cell` to `parent`, or an expansion of `cell` when
+    // parent is EXPANSION; searches without parents record expansions only
+    struct Event {
+        std::int32_t cell;
+        std::int32_t parent;
+
+        bool isExpansion() const { return parent == EXPANSION; }
+    };
+
+    static constexpr std::int32_t EXPANSION = -2;
+
+    // Capacity is rounded up to a power of two events
+    explicit SearchTrace(size_t capacity = size_t(1) << 20) {
+        size_t rounded = 1;
+        while (rounded < capacity) rounded <<= 1;
+        events_.resize(rounded);
+        mask_ = rounded - 1;
+    }
+
+    // Starts a new recording, keeping the buffer
+    void begin(const Maze& maze, const Maze::Point& start, const Maze::Point& goal, const std::string& algorithm) {
+        width_ = maze.getWidth();
+        height_ = maze.getHeight();
+        start_ = start;
+        goal_ = goal;
+        algorithm_ = algorithm;
+        recorded_ = 0;
+    }
+
+    void expansion(int cell) { push(cell, EXPANSION); }
+    void parent(int cell, int parent) { push(cell, parent); }
+
+    size_t capacity() const { return events_.size(); }
+    size_t size() const { return std::min(recorded_, events_.size()); }   // events kept
+    size_t recorded() const { return recorded_; }                         // events ever recorded
+    size_t dropped() const { return recorded_ - size(); }
+
+    // Kept events, oldest first
+    const Event& operator[](size_t i) const { return events_[(dropped() + i) & mask_]; }
+
+    int getWidth() const { return width_; }
+    int getHeight() const { return height_; }
+    const Maze::Point& getStart() const { return start_; }
+    const Maze::Point& getGoal() const { return goal_; }
+    const std::string& getAlgorithm() const { return algorithm_; }
+
+    bool save(const std::string& filename) const {
+        std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+
+        FileHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, "TRCE", 4);
+        header.version = FILE_VERSION;
+        header.width = width_;
+        header.height = height_;
+        header.startX = start_.x;
+        header.startY = start_.y;
+        header.goalX = goal_.x;
+        header.goalY = goal_.y;
+        header.recorded = recorded_;
+        header.events = size();
+        std::strncpy(header.algorithm, algorithm_.c_str(), sizeof(header.algorithm) - 1);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        // The kept events in order, in at most two runs of the ring
+        const size_t first = dropped() & mask_;
+        const size_t run = std::min(size(), events_.size() - first);
+        file.write(reinterpret_cast<const char*>(events_.data() + first), run * sizeof(Event));
+        file.write(reinterpret_cast<const char*>(events_.data()), (size() - run) * sizeof(Event));
+        return static_cast<bool>(file);
+    }
+
+    // Replaces this trace with a saved one, resizing the buffer to fit it
+    bool load(const std::string& filename) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) return false;
+        FileHeader header;
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            std::memcmp(header.magic, "TRCE", 4) != 0 || header.version != FILE_VERSION ||
+            header.events > header.recorded) {
+            return false;
+        }
+
+        std::vector<Event> events(header.events);
+        if (!file.read(reinterpret_cast<char*>(events.data()), events.size() * sizeof(Event))) return false;
+
+        // A trace that wrapped filled a buffer of exactly its kept events
+        const bool wrapped = header.recorded > header.events;
+        if (wrapped && (header.events == 0 || (header.events & (header.events - 1)) != 0)) return false;
+        size_t rounded = wrapped ? events.size() : events_.size();
+        while (rounded < events.size()) rounded <<= 1;
+        events_.assign(rounded, Event{0, EXPANSION});
+        mask_ = rounded - 1;
+        width_ = header.width;
+        height_ = header.height;
+        start_ = Maze::Point(header.startX, header.startY);
+        goal_ = Maze::Point(header.goalX, header.goalY);
+        header.algorithm[sizeof(header.algorithm) - 1] = '\0';
+        algorithm_ = header.algorithm;
+
+        // Kept events go back where they sat in the ring
+        recorded_ = header.recorded;
+        for (size_t i = 0; i < events.size(); ++i) events_[(dropped() + i) & mask_] = events[i];
+        return true;
+    }
+
+    size_t memoryUsage() const { return events_.capacity() * sizeof(Event); }
+
+private:
+    static constexpr std::uint32_t FILE_VERSION = 1;
+
+    struct FileHeader {
+        char magic[4];
+        std::uint32_t version;
+        std::int32_t width;
+        std::int32_t height;
+        std::int32_t startX;
+        std::int32_t startY;
+        std::int32_t goalX;
+        std::int32_t goalY;
+        std::uint64_t recorded;
+        std::uint64_t events;
+        char algorithm[64];
+    };
+
+    std::vector<Event> events_;
+    size_t mask_ = 0;
+    size_t recorded_ = 0;
+    int width_ = 0;
+    int height_ = 0;
+    Maze::Point start_;
+    Maze::Point goal_;
+    std::string algorithm_;
+
+    void push(int cell, int parent) {
+        events_[recorded_ & mask_] = Event{cell, parent};
+        ++recorded_;
+    }
+};
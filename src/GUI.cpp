@@ -1,10 +1,20 @@
 #include "GUI.hpp"
 #include "pathfinders/AStar.hpp"
 #include "pathfinders/Dijkstra.hpp"
+#include "pathfinders/BucketDijkstra.hpp"
 #include "pathfinders/BFS.hpp"
 #include "pathfinders/DFS.hpp"
 #include "pathfinders/GreedyBestFirst.hpp"
 #include "pathfinders/JPS.hpp"
+#include "pathfinders/JPSPlus.hpp"
+#include "pathfinders/HPAStar.hpp"
+#include "pathfinders/DStarLite.hpp"
+#include "pathfinders/ParallelBFS.hpp"
+#include "pathfinders/BitWavefront.hpp"
+#include "pathfinders/FlowField.hpp"
+#include "pathfinders/Bidirectional.hpp"
+#include "pathfinders/ALT.hpp"
+#include "pathfinders/ARAStar.hpp"
 #include "Benchmark.hpp"
 #include <fstream>
 #include <sstream>
@@ -18,10 +28,13 @@ GUI::GUI(int windowWidth, int windowHeight)
     , currentAlgorithm_(0)
     , isRunning_(false)
     , isDragging_(false)
+    , isPanning_(false)
     , currentDrawMode_(Maze::CellType::WALL)
     , isVisualizing_(false)
     , currentPath_()
     , currentNode_()
+    , stepsPerFrame_(16)
+    , replayPaused_(false)
 {
     initWindow(windowWidth, windowHeight);
     initUI();
@@ -171,13 +184,55 @@ void GUI::initAlgorithms() {
     algorithms_.push_back(std::make_unique<DFS>());
     algorithms_.push_back(std::make_unique<GreedyBestFirst>());
     algorithms_.push_back(std::make_unique<JPS>());
+
+    // Integer octile cost variants
+    algorithms_.push_back(std::make_unique<AStarOctile>());
+    algorithms_.push_back(std::make_unique<JPSOctile>());
+
+    // Precomputed jump tables, for static maps
+    algorithms_.push_back(std::make_unique<JPSPlus>());
+
+    // Cluster hierarchy, updated incrementally as the maze is edited
+    algorithms_.push_back(std::make_unique<HPAStar>());
+
+    // Incremental replanner, repairs its last search after edits
+    algorithms_.push_back(std::make_unique<DStarLite>());
+
+    // Multi-threaded BFS for very large unweighted maps
+    algorithms_.push_back(std::make_unique<ParallelBFS>());
+
+    // BFS layers as bitboard dilations over the packed rows
+    algorithms_.push_back(std::make_unique<BitWavefront>());
+
+    // One field per goal, shared by every agent heading there
+    algorithms_.push_back(std::make_unique<FlowFieldPathfinder>());
+
+    // Searches from both ends that stop once the two fronts meet
+    algorithms_.push_back(std::make_unique<BidirectionalBFS>());
+    algorithms_.push_back(std::make_unique<BidirectionalAStar>());
+
+    // A* bounded through precomputed landmark distances
+    algorithms_.push_back(std::make_unique<ALTAStar>());
+
+    // Anytime search: a quick inflated path, improved while time remains
+    algorithms_.push_back(std::make_unique<ARAStar>());
+
+    // Same searches over a pairing heap, for comparing open lists
+    algorithms_.push_back(std::make_unique<AStarPairing>());
+    algorithms_.push_back(std::make_unique<DijkstraPairing>());
+
+    // Bucket-queue Dijkstra variants for small integer step costs
+    algorithms_.push_back(std::make_unique<DialDijkstra>());
+    algorithms_.push_back(std::make_unique<RadixDijkstra>());
 }
 
 void GUI::run() {
     while (window_.isOpen()) {
         handleEvents();
+        stepSearch();
         draw();
     }
+    stopSearch();
 }
 
 void GUI::handleEvents() {
@@ -194,14 +249,24 @@ void GUI::handleEvents() {
 
             case sf::Event::MouseButtonReleased:
                 isDragging_ = false;
+                isPanning_ = false;
                 break;
 
             case sf::Event::MouseMoved:
-                if (isDragging_) {
+                if (isPanning_) {
+                    panView(sf::Mouse::getPosition(window_));
+                } else if (isDragging_) {
                     handleMouseDrag(sf::Mouse::getPosition(window_));
                 }
                 break;
 
+            case sf::Event::MouseWheelScrolled:
+                if (event.mouseWheelScroll.y < window_.getSize().y - UI_PANEL_HEIGHT) {
+                    zoomView(event.mouseWheelScroll.delta > 0 ? 1.f / ZOOM_STEP : ZOOM_STEP,
+                             sf::Vector2i(event.mouseWheelScroll.x, event.mouseWheelScroll.y));
+                }
+                break;
+
             case sf::Event::KeyPressed:
                 handleKeyPress(event);
                 break;
@@ -214,6 +279,13 @@ void GUI::handleEvents() {
 
 void GUI::handleMouseClick(const sf::Event& event) {
     sf::Vector2i mousePos(event.mouseButton.x, event.mouseButton.y);
+
+    // Middle button drags the view
+    if (event.mouseButton.button == sf::Mouse::Middle) {
+        isPanning_ = true;
+        panOrigin_ = mousePos;
+        return;
+    }
     
     // Check if clicked on the dropdown
     if (mousePos.y < UI_PANEL_HEIGHT) {
@@ -243,6 +315,7 @@ void GUI::handleMouseClick(const sf::Event& event) {
 void GUI::handleMouseDrag(const sf::Vector2i& mousePos) {
     sf::Vector2i gridPos = windowToGrid(mousePos);
     if (maze_.isValidCell(gridPos.x, gridPos.y)) {
+        stopSearch();
         maze_.setCellType(gridPos.x, gridPos.y, currentDrawMode_);
     }
 }
@@ -293,6 +366,48 @@ void GUI::handleKeyPress(const sf::Event& event) {
             }
             break;
 
+        case sf::Keyboard::Add:
+        case sf::Keyboard::Equal:
+            changeSpeed(true);
+            break;
+
+        case sf::Keyboard::Subtract:
+        case sf::Keyboard::Hyphen:
+            changeSpeed(false);
+            break;
+
+        case sf::Keyboard::Left:
+        case sf::Keyboard::Right:
+            scrubReplay(event.key.code == sf::Keyboard::Right);
+            break;
+
+        case sf::Keyboard::Home:
+            if (replay_) {
+                replayPaused_ = true;
+                seekReplay(0);
+            }
+            break;
+
+        case sf::Keyboard::End:
+            if (replay_) {
+                seekReplay(replay_->length());
+            }
+            break;
+
+        case sf::Keyboard::Enter:
+            replayPaused_ = !replayPaused_;
+            break;
+
+        case sf::Keyboard::T:
+            if (event.key.control) {
+                saveTrace();
+            }
+            break;
+
+        case sf::Keyboard::F:
+            fitView();
+            break;
+
         default:
             break;
     }
@@ -305,10 +420,6 @@ void GUI::draw() {
     window_.setView(mazeView_);
     drawMaze();
 
-    // Draw UI
-    window_.setView(uiView_);
-    drawUI();
-
     // Draw visualization elements
     if (isVisualizing_) {
         // Highlight current node being explored
@@ -321,11 +432,16 @@ void GUI::draw() {
         window_.draw(currentNodeMarker);
     }
 
+    // Draw UI
+    window_.setView(uiView_);
+    drawUI();
+
     window_.display();
 }
 
 void GUI::drawMaze() {
-    maze_.draw(window_, cellSize_);
+    renderer_.update(maze_);
+    renderer_.draw(window_, maze_, cellSize_);
 }
 
 void GUI::drawUI() {
@@ -374,68 +490,185 @@ void GUI::updateMetrics() {
         << "Nodes: " << lastResult_.nodesExplored << " | "
         << "Path: " << lastResult_.pathLength << " | "
         << "Memory: " << lastResult_.memoryUsage / 1024 << "KB";
+    if (!lastResult_.improvements.empty()) {
+        oss << " | Bound: " << lastResult_.suboptimalityBound;
+    }
     metrics_.setString(oss.str());
 }
 
 sf::Vector2i GUI::windowToGrid(const sf::Vector2i& windowPos) const {
+    const sf::Vector2f world = window_.mapPixelToCoords(windowPos, mazeView_);
     return sf::Vector2i(
-        static_cast<int>(windowPos.x / cellSize_),
-        static_cast<int>(windowPos.y / cellSize_)
+        static_cast<int>(std::floor(world.x / cellSize_)),
+        static_cast<int>(std::floor(world.y / cellSize_))
     );
 }
 
+// Zooms by a factor of the view size, keeping the point under the mouse
+// in place. The view stays between MIN_VISIBLE_CELLS cells wide and twice
+// the maze's longer side.
+void GUI::zoomView(float factor, const sf::Vector2i& mousePos) {
+    const float minWidth = MIN_VISIBLE_CELLS * cellSize_;
+    const float maxWidth = std::max({maze_.getWidth(), maze_.getHeight(), 1}) * cellSize_ * 2;
+    const float width = mazeView_.getSize().x;
+    const float newWidth = std::max(minWidth, std::min(maxWidth, width * factor));
+    if (newWidth == width) return;
+
+    const sf::Vector2f before = window_.mapPixelToCoords(mousePos, mazeView_);
+    mazeView_.zoom(newWidth / width);
+    const sf::Vector2f after = window_.mapPixelToCoords(mousePos, mazeView_);
+    mazeView_.move(before - after);
+}
+
+void GUI::panView(const sf::Vector2i& mousePos) {
+    mazeView_.move(window_.mapPixelToCoords(panOrigin_, mazeView_) - window_.mapPixelToCoords(mousePos, mazeView_));
+    panOrigin_ = mousePos;
+}
+
+// Shows the whole maze from its top-left corner, at one view unit per pixel
+// when it fits and scaled down otherwise
+void GUI::fitView() {
+    const float areaWidth = static_cast<float>(window_.getSize().x);
+    const float areaHeight = window_.getSize().y - UI_PANEL_HEIGHT;
+    const float scale = std::max({1.f, maze_.getWidth() * cellSize_ / areaWidth,
+                                  maze_.getHeight() * cellSize_ / areaHeight});
+    mazeView_.reset(sf::FloatRect(0, 0, areaWidth * scale, areaHeight * scale));
+}
+
 void GUI::runAlgorithm() {
     if (!algorithms_.empty()) {
+        stopSearch();
+
         // Reset visualization state
-        isVisualizing_ = true;
+        isVisualizing_ = false;
         currentPath_.clear();
         
         // Clear previous visualization
-        for (int y = 0; y < maze_.getHeight(); ++y) {
-            for (int x = 0; x < maze_.getWidth(); ++x) {
-                if (maze_.getCellType(x, y) == Maze::CellType::VISITED ||
-                    maze_.getCellType(x, y) == Maze::CellType::PATH_FOUND) {
-                    maze_.setCellType(x, y, Maze::CellType::PATH);
-                }
-            }
+        maze_.clearOverlay();
+
+        // Room for a few events per cell; a longer run keeps its latest ones
+        const size_t cellCount = static_cast<size_t>(maze_.getWidth()) * maze_.getHeight();
+        const size_t wanted = std::min(cellCount * 8, MAX_TRACE_EVENTS);
+        if (trace_.capacity() < wanted) {
+            trace_ = SearchTrace(wanted);
         }
 
-        // Create visualization callback
-        auto visualCallback = [this](const Maze::Point& current, const std::vector<Maze::Point>& path) {
-            currentNode_ = current;
-            currentPath_ = path;
-            maze_.setCellType(current.x, current.y, Maze::CellType::VISITED);
-            
-            // Update path visualization
-            for (const auto& p : path) {
-                maze_.setCellType(p.x, p.y, Maze::CellType::PATH_FOUND);
-            }
-        };
+        // Run the algorithm at full speed off the UI thread, recording it
+        // for the replay
+        algorithms_[currentAlgorithm_]->setTrace(&trace_);
+        search_ = std::make_unique<SteppedSearch>(*algorithms_[currentAlgorithm_], maze_,
+                                                  maze_.getStart(), maze_.getGoal(), false);
+        metrics_.setString(algorithms_[currentAlgorithm_]->getName() + "\nSearching...");
+    }
+}
 
-        // Run algorithm with visualization
-        lastResult_ = algorithms_[currentAlgorithm_]->findPath(maze_, true, visualCallback);
+void GUI::stepSearch() {
+    if (search_ && search_->finished()) {
+        lastResult_ = search_->result();
+        search_.reset();
+        algorithms_[currentAlgorithm_]->setTrace(nullptr);
         updateMetrics();
-        
-        // Final path visualization
-        for (const auto& p : lastResult_.path) {
-            maze_.setCellType(p.x, p.y, Maze::CellType::PATH_FOUND);
-        }
-        
-        isVisualizing_ = false;
+
+        replay_ = std::make_unique<TraceReplay>(trace_);
+        replayPaused_ = false;
+    }
+
+    // A frame's worth of trace events
+    if (replay_ && !replayPaused_ && !replay_->atEnd()) {
+        seekReplay(replay_->position() + stepsPerFrame_);
+    }
+}
+
+void GUI::seekReplay(size_t position) {
+    replay_->seek(position);
+    auto restore = [this](const Maze::Point& p) {
+        maze_.setOverlay(p.x, p.y, replay_->expanded(maze_.index(p.x, p.y)) ? Maze::CellType::VISITED
+                                                                             : Maze::CellType::PATH);
+    };
+    for (int cell : replay_->changedCells()) {
+        restore(maze_.pointAt(cell));
+    }
+
+    // Route to the latest expansion, or the query's path once replayed
+    for (const auto& p : currentPath_) {
+        restore(p);
+    }
+    if (replay_->atEnd()) {
+        currentPath_ = lastResult_.path;
+    } else if (replay_->current() >= 0) {
+        currentPath_ = replay_->pathTo(replay_->current());
+    } else {
+        currentPath_.clear();
+    }
+    for (const auto& p : currentPath_) {
+        maze_.setOverlay(p.x, p.y, Maze::CellType::PATH_FOUND);
+    }
+
+    isVisualizing_ = !replay_->atEnd() && replay_->current() >= 0;
+    if (isVisualizing_) {
+        currentNode_ = maze_.pointAt(replay_->current());
+    }
+}
+
+// Steps the replay by a frame's worth of events and holds it there
+void GUI::scrubReplay(bool forward) {
+    if (!replay_) {
+        return;
+    }
+    replayPaused_ = true;
+    const size_t position = replay_->position();
+    seekReplay(forward ? position + stepsPerFrame_ : position - std::min(position, stepsPerFrame_));
+}
+
+// The search reads the maze unlocked and the replay shows one maze state,
+// so anything that edits the maze or reuses the algorithms drops both first
+void GUI::stopSearch() {
+    if (search_) {
+        search_.reset();
+        algorithms_[currentAlgorithm_]->setTrace(nullptr);
+    }
+    replay_.reset();
+    isVisualizing_ = false;
+}
+
+void GUI::changeSpeed(bool faster) {
+    stepsPerFrame_ = faster ? std::min(stepsPerFrame_ * 2, MAX_STEPS_PER_FRAME)
+                            : std::max<size_t>(stepsPerFrame_ / 2, 1);
+}
+
+void GUI::saveTrace() {
+    if (!replay_) {
+        std::cout << "No finished run to save\n";
+        return;
+    }
+
+    std::string filename;
+    std::cout << "Enter trace file path to save the last run: ";
+    std::getline(std::cin, filename);
+
+    if (filename.empty()) {
+        return;
+    }
+
+    if (!trace_.save(filename)) {
+        std::cerr << "Could not write trace to " << filename << "\n";
     }
 }
 
 void GUI::nextAlgorithm() {
     if (!algorithms_.empty()) {
+        stopSearch();
         currentAlgorithm_ = (currentAlgorithm_ + 1) % algorithms_.size();
     }
 }
 
 void GUI::generateRandomMaze() {
+    stopSearch();
     maze_.generateRandom(maze_.getWidth(), maze_.getHeight(), 0.3f);
 }
 
 void GUI::clearMaze() {
+    stopSearch();
     maze_.clear();
 }
 
@@ -448,10 +681,20 @@ void GUI::loadMaze() {
         return;
     }
 
+    stopSearch();
+    bool loaded = false;
     if (filename.length() >= 4 && filename.substr(filename.length() - 4) == ".txt") {
-        maze_.loadFromASCII(filename);
+        loaded = maze_.loadFromASCII(filename);
     } else if (filename.length() >= 4 && filename.substr(filename.length() - 4) == ".png") {
-        maze_.loadFromPNG(filename);
+        loaded = maze_.loadFromPNG(filename);
+    }
+
+    // Pick up preprocessing saved next to the maze, if it still matches
+    if (loaded) {
+        for (auto& algorithm : algorithms_) {
+            algorithm->loadPreprocessing(maze_, filename);
+        }
+        fitView();
     }
 }
 
@@ -468,12 +711,24 @@ void GUI::saveMaze() {
         filename += ".png";
     }
 
-    maze_.saveToPNG(filename);
+    stopSearch();
+    if (maze_.saveToPNG(filename)) {
+        for (auto& algorithm : algorithms_) {
+            algorithm->savePreprocessing(maze_, filename);
+        }
+    }
 }
 
 void GUI::runBenchmark() {
+    stopSearch();
+
     // Create benchmark instance
     Benchmark benchmark(algorithms_);
+
+    // Keep the window responsive whatever an algorithm does with the maze
+    Pathfinder::SearchLimits limits;
+    limits.timeBudgetMs = BENCHMARK_QUERY_BUDGET_MS;
+    benchmark.setQueryLimits(limits);
     
     // Run benchmarks
     auto results = benchmark.runBenchmarks(maze_, 10, true);
@@ -481,6 +736,7 @@ void GUI::runBenchmark() {
     // Export results
     benchmark.exportToCSV(results, "benchmark_results.csv");
     benchmark.exportToMarkdown(results, "benchmark_results.md");
+    benchmark.exportAnytimeCSV(maze_, "anytime_profile.csv");
     
     // Update metrics with benchmark summary
     std::ostringstream oss;
@@ -509,6 +765,7 @@ void GUI::handleDropdownClick(const sf::Vector2i& mousePos) {
             );
 
             if (optionBounds.contains(mousePos.x, mousePos.y)) {
+                stopSearch();
                 currentAlgorithm_ = i;
                 algorithmDropdown_.selectedText.setString(algorithms_[i]->getName());
                 algorithmDropdown_.isOpen = false;
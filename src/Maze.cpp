@@ -3,8 +3,62 @@
 #include <sstream>
 #include <stdexcept>
 #include <random>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <unordered_set>
+
+namespace {
+    std::uint64_t nextWalkabilityStamp() {
+        static std::atomic<std::uint64_t> counter{0};
+        return ++counter;
+    }
+
+    // Union-find over cell indices for the component rebuild. The larger
+    // root is attached to the smaller, so every root is the first cell of
+    // its component in row-major order.
+    int findRoot(std::vector<int>& parent, int cell) {
+        while (parent[cell] != cell) {
+            parent[cell] = parent[parent[cell]];
+            cell = parent[cell];
+        }
+        return cell;
+    }
+
+    void unite(std::vector<int>& parent, int a, int b) {
+        a = findRoot(parent, a);
+        b = findRoot(parent, b);
+        if (a < b) {
+            parent[b] = a;
+        } else if (b < a) {
+            parent[a] = b;
+        }
+    }
 
-Maze::Maze() : width_(0), height_(0) {}
+    // Rows per strip below which another rebuild thread is not worth starting
+    constexpr int MIN_STRIP_ROWS = 128;
+
+    // Local searches confirming that an edit did not split a component give
+    // up after this many cells and fall back to a rebuild
+    constexpr size_t SPLIT_SEARCH_BUDGET = 4096;
+}
+
+Maze::Maze() : displayAll_(true), rowWords_(0), columnWords_(0), width_(0), height_(0), editDepth_(0), revision_(0),
+               walkabilityStamp_(nextWalkabilityStamp()), componentsStale_(true) {}
+
+void Maze::Rect::include(const Rect& other) {
+    if (other.empty()) return;
+    if (empty()) {
+        *this = other;
+        return;
+    }
+    int right = std::max(x + width, other.x + other.width);
+    int bottom = std::max(y + height, other.y + other.height);
+    x = std::min(x, other.x);
+    y = std::min(y, other.y);
+    width = right - x;
+    height = bottom - y;
+}
 
 bool Maze::loadFromASCII(const std::string& filename) {
     std::ifstream file(filename);
@@ -19,29 +73,30 @@ bool Maze::loadFromASCII(const std::string& filename) {
 
     if (lines.empty()) return false;
 
-    height_ = lines.size();
-    width_ = lines[0].length();
-    grid_.resize(height_, std::vector<CellType>(width_, CellType::PATH));
+    beginEdit();
+    resize(lines[0].length(), lines.size());
 
     for (int y = 0; y < height_; ++y) {
         for (int x = 0; x < width_; ++x) {
-            char c = lines[y][x];
+            char c = x < static_cast<int>(lines[y].length()) ? lines[y][x] : '0';
+            CellType& cell = terrain_[index(x, y)];
             switch (c) {
-                case '0': grid_[y][x] = CellType::PATH; break;
-                case '1': grid_[y][x] = CellType::WALL; break;
+                case '0': cell = CellType::PATH; break;
+                case '1': cell = CellType::WALL; break;
                 case 'S': 
-                    grid_[y][x] = CellType::START;
+                    cell = CellType::START;
                     start_ = Point(x, y);
                     break;
                 case 'G': 
-                    grid_[y][x] = CellType::GOAL;
+                    cell = CellType::GOAL;
                     goal_ = Point(x, y);
                     break;
-                default: grid_[y][x] = CellType::PATH;
+                default: cell = CellType::PATH;
             }
         }
     }
 
+    commit();
     return true;
 }
 
@@ -49,9 +104,8 @@ bool Maze::loadFromPNG(const std::string& filename) {
     sf::Image image;
     if (!image.loadFromFile(filename)) return false;
 
-    width_ = image.getSize().x;
-    height_ = image.getSize().y;
-    grid_.resize(height_, std::vector<CellType>(width_, CellType::PATH));
+    beginEdit();
+    resize(image.getSize().x, image.getSize().y);
 
     bool foundStart = false;
     bool foundGoal = false;
@@ -59,26 +113,27 @@ bool Maze::loadFromPNG(const std::string& filename) {
     for (int y = 0; y < height_; ++y) {
         for (int x = 0; x < width_; ++x) {
             sf::Color pixel = image.getPixel(x, y);
+            CellType& cell = terrain_[index(x, y)];
             
             // Convert to grayscale for better wall detection
             float grayscale = (pixel.r * 0.299f + pixel.g * 0.587f + pixel.b * 0.114f) / 255.f;
 
             // Check specific colors first
             if (pixel.g > 200 && pixel.r < 100 && pixel.b < 100) {  // Green for start
-                grid_[y][x] = CellType::START;
+                cell = CellType::START;
                 start_ = Point(x, y);
                 foundStart = true;
             }
             else if (pixel.r > 200 && pixel.g < 100 && pixel.b < 100) {  // Red for goal
-                grid_[y][x] = CellType::GOAL;
+                cell = CellType::GOAL;
                 goal_ = Point(x, y);
                 foundGoal = true;
             }
             else if (grayscale < 0.5f) {  // Dark pixels are walls
-                grid_[y][x] = CellType::WALL;
+                cell = CellType::WALL;
             }
             else {  // Light pixels are paths
-                grid_[y][x] = CellType::PATH;
+                cell = CellType::PATH;
             }
         }
     }
@@ -86,13 +141,14 @@ bool Maze::loadFromPNG(const std::string& filename) {
     // If start/goal not found, set defaults
     if (!foundStart) {
         start_ = Point(0, 0);
-        grid_[0][0] = CellType::START;
+        terrain_[index(0, 0)] = CellType::START;
     }
     if (!foundGoal) {
         goal_ = Point(width_ - 1, height_ - 1);
-        grid_[height_ - 1][width_ - 1] = CellType::GOAL;
+        terrain_[index(width_ - 1, height_ - 1)] = CellType::GOAL;
     }
 
+    commit();
     return true;
 }
 
@@ -102,7 +158,7 @@ bool Maze::saveToPNG(const std::string& filename) const {
 
     for (int y = 0; y < height_; ++y) {
         for (int x = 0; x < width_; ++x) {
-            switch (grid_[y][x]) {
+            switch (displayType(index(x, y))) {
                 case CellType::WALL:
                     image.setPixel(x, y, sf::Color::Black);
                     break;
@@ -131,29 +187,148 @@ bool Maze::saveToPNG(const std::string& filename) const {
 void Maze::resize(int width, int height) {
     width_ = width;
     height_ = height;
-    grid_.resize(height_, std::vector<CellType>(width_, CellType::PATH));
+    terrain_.assign(static_cast<size_t>(width_) * height_, CellType::PATH);
+    overlay_.assign(terrain_.size(), CellType::PATH);
+    overlayCells_.clear();
+    passable_.assign(static_cast<size_t>(width_ + 2) * (height_ + 2), 0);
+    neighborMask_.assign(terrain_.size(), 0);
+    rowWords_ = (BITMAP_OFFSET + width_ + 1) / 64 + 2;
+    columnWords_ = (BITMAP_OFFSET + height_ + 1) / 64 + 2;
+    rowBits_.assign(rowWords_ * (height_ + 2), 0);
+    columnBits_.assign(columnWords_ * (width_ + 2), 0);
+    walkabilityStamp_ = nextWalkabilityStamp();
+    walkabilityJournal_.clear();
+    component_.assign(terrain_.size(), NO_COMPONENT);
+    labelParent_.clear();
+    componentsStale_ = true;
+
+    beginEdit();
+    markDirty(Rect(0, 0, width_, height_));
+    commit();
 }
 
 void Maze::setCellType(int x, int y, CellType type) {
     if (!isValidCell(x, y)) return;
-    grid_[y][x] = type;
-    updateStartGoal();
+    if (type == CellType::VISITED || type == CellType::PATH_FOUND) {
+        setOverlay(x, y, type);
+        return;
+    }
+    beginEdit();
+    writeTerrain(x, y, type);
+    commit();
+}
+
+void Maze::beginEdit() {
+    ++editDepth_;
+}
+
+Maze::Rect Maze::commit() {
+    if (editDepth_ == 0 || --editDepth_ > 0) return Rect();
+
+    Rect dirty = pendingDirty_;
+    pendingDirty_ = Rect();
+    if (!dirty.empty()) {
+        if (refreshWalkability(dirty)) {
+            updateComponents();
+            if (walkabilityJournal_.size() == WALKABILITY_JOURNAL_SIZE) {
+                walkabilityJournal_.erase(walkabilityJournal_.begin());
+            }
+            walkabilityJournal_.push_back(WalkabilityChange{walkabilityStamp_, dirty});
+            walkabilityStamp_ = nextWalkabilityStamp();
+        }
+        ++revision_;
+    }
+    return dirty;
+}
+
+bool Maze::getWalkabilityChanges(std::uint64_t sinceStamp, Rect& area) const {
+    area = Rect();
+    if (sinceStamp == walkabilityStamp_) return true;
+
+    for (size_t i = 0; i < walkabilityJournal_.size(); ++i) {
+        if (walkabilityJournal_[i].fromStamp != sinceStamp) continue;
+        for (size_t j = i; j < walkabilityJournal_.size(); ++j) {
+            area.include(walkabilityJournal_[j].area);
+        }
+        return true;
+    }
+    return false;
+}
+
+void Maze::fillRect(const Rect& area, CellType type) {
+    int x0 = std::max(area.x, 0);
+    int y0 = std::max(area.y, 0);
+    int x1 = std::min(area.x + area.width, width_);
+    int y1 = std::min(area.y + area.height, height_);
+
+    beginEdit();
+    for (int y = y0; y < y1; ++y) {
+        for (int x = x0; x < x1; ++x) {
+            if (type == CellType::VISITED || type == CellType::PATH_FOUND) {
+                setOverlay(x, y, type);
+            } else {
+                writeTerrain(x, y, type);
+            }
+        }
+    }
+    commit();
 }
 
 Maze::CellType Maze::getCellType(int x, int y) const {
     if (!isValidCell(x, y)) throw std::out_of_range("Cell coordinates out of bounds");
-    return grid_[y][x];
+    return displayType(index(x, y));
 }
 
-void Maze::clear() {
-    for (auto& row : grid_) {
-        std::fill(row.begin(), row.end(), CellType::PATH);
+Maze::CellType Maze::getTerrain(int x, int y) const {
+    if (!isValidCell(x, y)) throw std::out_of_range("Cell coordinates out of bounds");
+    return terrain_[index(x, y)];
+}
+
+void Maze::setOverlay(int x, int y, CellType type) {
+    if (!isValidCell(x, y)) return;
+    CellType& cell = overlay_[index(x, y)];
+    if (cell == type) return;
+    if (cell == CellType::PATH) {
+        overlayCells_.push_back(index(x, y));
+    }
+    cell = type;
+    markDisplayChanged(index(x, y));
+}
+
+Maze::CellType Maze::getOverlay(int x, int y) const {
+    if (!isValidCell(x, y)) throw std::out_of_range("Cell coordinates out of bounds");
+    return overlay_[index(x, y)];
+}
+
+void Maze::clearOverlay() {
+    for (int i : overlayCells_) {
+        if (overlay_[i] == CellType::PATH) continue;
+        overlay_[i] = CellType::PATH;
+        markDisplayChanged(i);
     }
+    overlayCells_.clear();
+}
+
+bool Maze::takeDisplayChanges(std::vector<int>& cells) {
+    cells.clear();
+    cells.swap(displayChanges_);
+    const bool all = displayAll_;
+    displayAll_ = false;
+    return all;
+}
+
+void Maze::clear() {
+    beginEdit();
+    std::fill(terrain_.begin(), terrain_.end(), CellType::PATH);
+    markDirty(Rect(0, 0, width_, height_));
+    clearOverlay();
     start_ = Point(0, 0);
     goal_ = Point(width_ - 1, height_ - 1);
+    commit();
 }
 
 void Maze::generateRandom(int width, int height, float wallDensity) {
+    beginEdit();
     resize(width, height);
     clear();
 
@@ -164,72 +339,311 @@ void Maze::generateRandom(int width, int height, float wallDensity) {
     for (int y = 0; y < height_; ++y) {
         for (int x = 0; x < width_; ++x) {
             if (dis(gen) < wallDensity) {
-                grid_[y][x] = CellType::WALL;
+                terrain_[index(x, y)] = CellType::WALL;
             }
         }
     }
 
     // Ensure start and goal are paths
-    grid_[start_.y][start_.x] = CellType::START;
-    grid_[goal_.y][goal_.x] = CellType::GOAL;
+    terrain_[index(start_.x, start_.y)] = CellType::START;
+    terrain_[index(goal_.x, goal_.y)] = CellType::GOAL;
+    commit();
+}
+
+void Maze::validatePoint(const Point& p) const {
+    if (!isValidCell(p.x, p.y)) {
+        throw std::out_of_range("Point coordinates out of bounds");
+    }
+}
+
+void Maze::writeTerrain(int x, int y, CellType type) {
+    // Start and goal are unique: placing a new one demotes the old cell, so
+    // their positions are tracked without ever rescanning the grid
+    Point p(x, y);
+    if (type == CellType::START && start_ != p) {
+        if (isValidCell(start_.x, start_.y) &&
+            terrain_[index(start_.x, start_.y)] == CellType::START) {
+            terrain_[index(start_.x, start_.y)] = CellType::PATH;
+            markDirty(Rect(start_.x, start_.y, 1, 1));
+        }
+        start_ = p;
+    } else if (type == CellType::GOAL && goal_ != p) {
+        if (isValidCell(goal_.x, goal_.y) &&
+            terrain_[index(goal_.x, goal_.y)] == CellType::GOAL) {
+            terrain_[index(goal_.x, goal_.y)] = CellType::PATH;
+            markDirty(Rect(goal_.x, goal_.y, 1, 1));
+        }
+        goal_ = p;
+    }
+
+    int i = index(x, y);
+    if (overlay_[i] != CellType::PATH) {
+        overlay_[i] = CellType::PATH;
+        markDisplayChanged(i);
+    }
+    if (terrain_[i] == type) return;
+    terrain_[i] = type;
+    markDirty(Rect(x, y, 1, 1));
 }
 
-bool Maze::isValidCell(int x, int y) const {
-    return x >= 0 && x < width_ && y >= 0 && y < height_;
+void Maze::markDirty(const Rect& area) {
+    pendingDirty_.include(area);
+    if (area.width == 1 && area.height == 1) {
+        markDisplayChanged(index(area.x, area.y));
+    } else if (!area.empty()) {
+        displayAll_ = true;
+        displayChanges_.clear();
+    }
 }
 
-bool Maze::isWalkable(int x, int y) const {
-    if (!isValidCell(x, y)) return false;
-    return grid_[y][x] != CellType::WALL;
+void Maze::markDisplayChanged(int index) {
+    if (displayAll_) return;
+    if (displayChanges_.size() >= terrain_.size() / 4) {
+        displayAll_ = true;
+        displayChanges_.clear();
+        return;
+    }
+    displayChanges_.push_back(index);
 }
 
-void Maze::draw(sf::RenderWindow& window, float cellSize) const {
-    sf::RectangleShape cell(sf::Vector2f(cellSize - 1, cellSize - 1));
+bool Maze::refreshWalkability(const Rect& area) {
+    // Mirror the changed cells into the padded grid and the bit lines
+    int x0 = std::max(area.x, 0);
+    int y0 = std::max(area.y, 0);
+    int x1 = std::min(area.x + area.width, width_);
+    int y1 = std::min(area.y + area.height, height_);
+    const int stride = width_ + 2;
+    bool changed = false;
+    for (int y = y0; y < y1; ++y) {
+        std::uint64_t* row = rowBits_.data() + static_cast<size_t>(y + 1) * rowWords_;
+        for (int x = x0; x < x1; ++x) {
+            const bool walkable = terrain_[index(x, y)] != CellType::WALL;
+            std::uint8_t& passable = passable_[static_cast<size_t>(y + 1) * stride + (x + 1)];
+            if (passable != walkable) {
+                changed = true;
+                if (flippedCells_.size() < MAX_COMPONENT_PATCH) {
+                    flippedCells_.push_back(index(x, y));
+                } else {
+                    componentsStale_ = true;
+                }
+            }
+            passable = walkable;
+
+            std::uint64_t* column = columnBits_.data() + static_cast<size_t>(x + 1) * columnWords_;
+            const int rowBit = BITMAP_OFFSET + x;
+            const int columnBit = BITMAP_OFFSET + y;
+            if (walkable) {
+                row[rowBit >> 6] |= std::uint64_t(1) << (rowBit & 63);
+                column[columnBit >> 6] |= std::uint64_t(1) << (columnBit & 63);
+            } else {
+                row[rowBit >> 6] &= ~(std::uint64_t(1) << (rowBit & 63));
+                column[columnBit >> 6] &= ~(std::uint64_t(1) << (columnBit & 63));
+            }
+        }
+    }
 
-    for (int y = 0; y < height_; ++y) {
-        for (int x = 0; x < width_; ++x) {
-            cell.setPosition(x * cellSize, y * cellSize);
+    // A cell's mask depends on its eight neighbours, so one ring around the
+    // changed area has to be recomputed as well
+    x0 = std::max(x0 - 1, 0);
+    y0 = std::max(y0 - 1, 0);
+    x1 = std::min(x1 + 1, width_);
+    y1 = std::min(y1 + 1, height_);
+    for (int y = y0; y < y1; ++y) {
+        for (int x = x0; x < x1; ++x) {
+            std::uint8_t mask = 0;
+            for (int d = 0; d < DIRECTION_COUNT; ++d) {
+                mask |= static_cast<std::uint8_t>(isPassable(x + DIRECTION_DX[d], y + DIRECTION_DY[d])) << d;
+            }
+            neighborMask_[index(x, y)] = mask;
+        }
+    }
+    return changed;
+}
 
-            switch (grid_[y][x]) {
-                case CellType::WALL:
-                    cell.setFillColor(sf::Color::Black);
-                    break;
-                case CellType::PATH:
-                    cell.setFillColor(sf::Color::White);
-                    break;
-                case CellType::START:
-                    cell.setFillColor(sf::Color::Green);
-                    break;
-                case CellType::GOAL:
-                    cell.setFillColor(sf::Color::Red);
-                    break;
-                case CellType::VISITED:
-                    cell.setFillColor(sf::Color(255, 255, 0, 128)); // Semi-transparent yellow
-                    break;
-                case CellType::PATH_FOUND:
-                    cell.setFillColor(sf::Color::Blue);
-                    break;
+void Maze::updateComponents() {
+    if (componentsStale_) {
+        rebuildComponents();
+        return;
+    }
+
+    // Cells that became walls drop their label. Their walkable neighbours
+    // are where the component could have come apart.
+    std::vector<int> boundary;
+    for (int cell : flippedCells_) {
+        const Point p = pointAt(cell);
+        if (isPassable(p.x, p.y)) continue;
+        component_[cell] = NO_COMPONENT;
+        for (int d = 0; d < DIRECTION_COUNT; ++d) {
+            const int x = p.x + DIRECTION_DX[d];
+            const int y = p.y + DIRECTION_DY[d];
+            if (isPassable(x, y) && component_[index(x, y)] != NO_COMPONENT) {
+                boundary.push_back(index(x, y));
             }
+        }
+    }
+    if (splitsComponents(boundary)) {
+        rebuildComponents();
+        return;
+    }
 
-            window.draw(cell);
+    // Cells that became walkable join, and so merge, the components of
+    // their neighbours, or start a component of their own
+    for (int cell : flippedCells_) {
+        const Point p = pointAt(cell);
+        if (!isPassable(p.x, p.y)) continue;
+        int label = NO_COMPONENT;
+        for (int d = 0; d < DIRECTION_COUNT; ++d) {
+            const int x = p.x + DIRECTION_DX[d];
+            const int y = p.y + DIRECTION_DY[d];
+            if (!isPassable(x, y)) continue;
+            int& neighbor = component_[index(x, y)];
+            if (neighbor == NO_COMPONENT) continue;
+            int root = neighbor;
+            while (labelParent_[root] != root) root = labelParent_[root];
+            labelParent_[neighbor] = root;
+            neighbor = root;
+            if (label == NO_COMPONENT || root < label) {
+                if (label != NO_COMPONENT) labelParent_[label] = root;
+                label = root;
+            } else if (root != label) {
+                labelParent_[root] = label;
+            }
+        }
+        if (label == NO_COMPONENT) {
+            label = static_cast<int>(labelParent_.size());
+            labelParent_.push_back(label);
         }
+        component_[cell] = label;
     }
+    flippedCells_.clear();
 }
 
-void Maze::validatePoint(const Point& p) const {
-    if (!isValidCell(p.x, p.y)) {
-        throw std::out_of_range("Point coordinates out of bounds");
+bool Maze::splitsComponents(std::vector<int>& boundary) {
+    // Any walk that crossed the new walls entered and left them through
+    // boundary cells of one component, so the components survive exactly
+    // when each one's boundary cells still reach each other. A bounded
+    // search from the first boundary cell of every component checks that;
+    // running out of budget counts as a split.
+    auto rootOf = [this](int cell) {
+        int label = component_[cell];
+        while (labelParent_[label] != label) label = labelParent_[label];
+        return label;
+    };
+    std::sort(boundary.begin(), boundary.end(), [&](int a, int b) {
+        const int rootA = rootOf(a);
+        const int rootB = rootOf(b);
+        return rootA != rootB ? rootA < rootB : a < b;
+    });
+    boundary.erase(std::unique(boundary.begin(), boundary.end()), boundary.end());
+
+    std::vector<int> frontier;
+    std::unordered_set<int> reached;
+    for (size_t first = 0; first < boundary.size();) {
+        const int root = rootOf(boundary[first]);
+        size_t last = first + 1;
+        while (last < boundary.size() && rootOf(boundary[last]) == root) ++last;
+        if (last - first > 1) {
+            size_t remaining = last - first - 1;
+            frontier.assign(1, boundary[first]);
+            reached.clear();
+            reached.insert(boundary[first]);
+            for (size_t head = 0; head < frontier.size() && remaining > 0; ++head) {
+                const Point p = pointAt(frontier[head]);
+                for (int d = 0; d < DIRECTION_COUNT; ++d) {
+                    if (!(neighborMask_[frontier[head]] & (1u << d))) continue;
+                    const int next = index(p.x + DIRECTION_DX[d], p.y + DIRECTION_DY[d]);
+                    if (!reached.insert(next).second) continue;
+                    if (reached.size() > SPLIT_SEARCH_BUDGET) return true;
+                    frontier.push_back(next);
+                    if (std::binary_search(boundary.begin() + first + 1, boundary.begin() + last, next)) {
+                        --remaining;
+                    }
+                }
+            }
+            if (remaining > 0) return true;
+        }
+        first = last;
     }
+    return false;
 }
 
-void Maze::updateStartGoal() {
-    for (int y = 0; y < height_; ++y) {
-        for (int x = 0; x < width_; ++x) {
-            if (grid_[y][x] == CellType::START) {
-                start_ = Point(x, y);
-            } else if (grid_[y][x] == CellType::GOAL) {
-                goal_ = Point(x, y);
+void Maze::rebuildComponents() {
+    const int cellCount = width_ * height_;
+    std::vector<int> parent(cellCount);
+
+    // Each strip of rows is labelled on its own thread, touching only its
+    // own cells; the seams between strips are joined afterwards. Of the
+    // neighbours already visited, the one above touches all the others, and
+    // left touches above-left, so most cells need a single lookup.
+    auto labelStrip = [&](int y0, int y1) {
+        for (int y = y0; y < y1; ++y) {
+            const bool hasRowAbove = y > y0;
+            for (int x = 0; x < width_; ++x) {
+                const int cell = index(x, y);
+                parent[cell] = cell;
+                if (!isPassable(x, y)) continue;
+                if (hasRowAbove && isPassable(x, y - 1)) {
+                    parent[cell] = findRoot(parent, cell - width_);
+                    continue;
+                }
+                if (isPassable(x - 1, y)) {
+                    parent[cell] = findRoot(parent, cell - 1);
+                } else if (hasRowAbove && isPassable(x - 1, y - 1)) {
+                    parent[cell] = findRoot(parent, cell - width_ - 1);
+                }
+                if (hasRowAbove && isPassable(x + 1, y - 1)) unite(parent, cell, cell - width_ + 1);
+            }
+        }
+    };
+
+    int strips = static_cast<int>(std::thread::hardware_concurrency());
+    strips = std::max(1, std::min(strips, height_ / MIN_STRIP_ROWS));
+    const int rowsPerStrip = (height_ + strips - 1) / strips;
+    if (strips == 1) {
+        labelStrip(0, height_);
+    } else {
+        std::vector<std::thread> workers;
+        for (int y0 = 0; y0 < height_; y0 += rowsPerStrip) {
+            workers.emplace_back(labelStrip, y0, std::min(y0 + rowsPerStrip, height_));
+        }
+        for (std::thread& worker : workers) worker.join();
+        for (int y = rowsPerStrip; y < height_; y += rowsPerStrip) {
+            for (int x = 0; x < width_; ++x) {
+                if (!isPassable(x, y)) continue;
+                for (int dx = -1; dx <= 1; ++dx) {
+                    if (isPassable(x + dx, y - 1)) unite(parent, index(x, y), index(x + dx, y - 1));
+                }
+            }
+        }
+    }
+
+    // Roots come first in row-major order, so one pass numbers them densely
+    labelParent_.clear();
+    for (int y = 0, cell = 0; y < height_; ++y) {
+        for (int x = 0; x < width_; ++x, ++cell) {
+            if (!isPassable(x, y)) {
+                component_[cell] = NO_COMPONENT;
+                continue;
+            }
+            const int root = findRoot(parent, cell);
+            if (root == cell) {
+                component_[cell] = static_cast<int>(labelParent_.size());
+                labelParent_.push_back(component_[cell]);
+            } else {
+                component_[cell] = component_[root];
             }
         }
     }
-} 
\ No newline at end of file
+    flippedCells_.clear();
+    componentsStale_ = false;
+}
+
+Maze::CellType Maze::displayType(int index) const {
+    // Start and goal stay visible on top of the search overlay
+    CellType terrain = terrain_[index];
+    if (overlay_[index] == CellType::PATH ||
+        terrain == CellType::START || terrain == CellType::GOAL) {
+        return terrain;
+    }
+    return overlay_[index];
+}
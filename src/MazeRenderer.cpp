@@ -0,0 +1,291 @@
+#include "MazeRenderer.hpp"
+#include <algorithm>
+#include <cmath>
+
+MazeRenderer::MazeRenderer(sf::Color gridColor) : gridColor_(gridColor), grid_(sf::Lines) {
+    // Level 0 draws visited cells half transparent over the background;
+    // coarser levels are opaque and mix in that same colour
+    const sf::Color visited = colorOf(Maze::CellType::VISITED);
+    auto over = [&](std::uint8_t top, std::uint8_t bottom) {
+        return static_cast<std::uint8_t>((top * visited.a + bottom * (255 - visited.a)) / 255);
+    };
+    visitedColor_ = sf::Color(over(visited.r, gridColor.r), over(visited.g, gridColor.g), over(visited.b, gridColor.b));
+}
+
+sf::Color MazeRenderer::colorOf(Maze::CellType type) {
+    switch (type) {
+        case Maze::CellType::WALL:
+            return sf::Color::Black;
+        case Maze::CellType::START:
+            return sf::Color::Green;
+        case Maze::CellType::GOAL:
+            return sf::Color::Red;
+        case Maze::CellType::VISITED:
+            return sf::Color(255, 255, 0, 128);  // Semi-transparent yellow
+        case Maze::CellType::PATH_FOUND:
+            return sf::Color::Blue;
+        default:  // PATH
+            return sf::Color::White;
+    }
+}
+
+int MazeRenderer::levelFor(float pixelsPerCell) {
+    int level = 0;
+    while (level < MAX_LEVEL && pixelsPerCell * static_cast<float>(1 << level) < 1.f) ++level;
+    return level;
+}
+
+void MazeRenderer::update(Maze& maze) {
+    bool all = maze.takeDisplayChanges(changes_);
+    if (maze.getWidth() != width_ || maze.getHeight() != height_) {
+        resize(maze.getWidth(), maze.getHeight());
+        all = true;
+    }
+
+    if (all) {
+        for (auto& entry : tiles_) entry.second.dirty = true;
+        pyramidStale_ = true;
+        return;
+    }
+    if (changes_.empty()) return;
+
+    // Patching costs a few dozen cell reads per change; past that a rebuild
+    // of the pyramid is cheaper
+    if (changes_.size() > static_cast<size_t>(width_) * height_ / 64) pyramidStale_ = true;
+
+    // Only the levels with tiles in the cache need looking at
+    std::uint32_t cachedLevels = 0;
+    for (const auto& entry : tiles_) cachedLevels |= 1u << (entry.first >> 56);
+
+    for (int cell : changes_) {
+        if (!pyramidStale_) patchPyramid(maze, cell);
+        const int x = cell % width_;
+        const int y = cell / width_;
+        for (std::uint32_t levels = cachedLevels; levels != 0; levels &= levels - 1) {
+            int level = 0;
+            while (!(levels & (1u << level))) ++level;
+            auto tile = tiles_.find(tileKey(level, (x >> level) / TILE_SIZE, (y >> level) / TILE_SIZE));
+            if (tile != tiles_.end()) tile->second.dirty = true;
+        }
+    }
+}
+
+void MazeRenderer::draw(sf::RenderTarget& target, const Maze& maze, float cellSize) {
+    const sf::View& view = target.getView();
+    const sf::Vector2f center = view.getCenter();
+    const sf::Vector2f size = view.getSize();
+    const float viewportPixels = target.getSize().x * view.getViewport().width;
+    if (size.x <= 0 || viewportPixels <= 0) return;
+    const float pixelsPerCell = cellSize * viewportPixels / size.x;
+
+    // Cells at least partly in view
+    const int x0 = std::max(0, static_cast<int>(std::floor((center.x - size.x / 2) / cellSize)));
+    const int y0 = std::max(0, static_cast<int>(std::floor((center.y - size.y / 2) / cellSize)));
+    const int x1 = std::min(width_, static_cast<int>(std::ceil((center.x + size.x / 2) / cellSize)));
+    const int y1 = std::min(height_, static_cast<int>(std::ceil((center.y + size.y / 2) / cellSize)));
+    if (x0 >= x1 || y0 >= y1) return;
+
+    const int level = std::min(levelFor(pixelsPerCell), topLevel_);
+    prepare(maze, Maze::Rect(x0, y0, x1 - x0, y1 - y0), level);
+
+    const float texelSize = cellSize * static_cast<float>(1 << level);
+    const float tileSize = texelSize * TILE_SIZE;
+    for (int ty = (y0 >> level) / TILE_SIZE; ty <= ((y1 - 1) >> level) / TILE_SIZE; ++ty) {
+        for (int tx = (x0 >> level) / TILE_SIZE; tx <= ((x1 - 1) >> level) / TILE_SIZE; ++tx) {
+            sf::Sprite sprite(tiles_[tileKey(level, tx, ty)].texture);
+            sprite.setPosition(tx * tileSize, ty * tileSize);
+            sprite.setScale(texelSize, texelSize);
+            target.draw(sprite);
+        }
+    }
+
+    // One-pixel gaps along the right and bottom edge of the cells in view
+    if (pixelsPerCell >= MIN_GRID_CELL_SIZE) {
+        const float offset = 0.5f * size.x / viewportPixels;
+        grid_.clear();
+        for (int x = x0 + 1; x <= x1; ++x) {
+            const float px = x * cellSize - offset;
+            grid_.append(sf::Vertex(sf::Vector2f(px, y0 * cellSize), gridColor_));
+            grid_.append(sf::Vertex(sf::Vector2f(px, y1 * cellSize), gridColor_));
+        }
+        for (int y = y0 + 1; y <= y1; ++y) {
+            const float py = y * cellSize - offset;
+            grid_.append(sf::Vertex(sf::Vector2f(x0 * cellSize, py), gridColor_));
+            grid_.append(sf::Vertex(sf::Vector2f(x1 * cellSize, py), gridColor_));
+        }
+        target.draw(grid_);
+    }
+}
+
+size_t MazeRenderer::prepare(const Maze& maze, const Maze::Rect& cells, int level) {
+    ++frame_;
+    const int x0 = std::max(cells.x, 0);
+    const int y0 = std::max(cells.y, 0);
+    const int x1 = std::min(cells.x + cells.width, width_);
+    const int y1 = std::min(cells.y + cells.height, height_);
+    if (x0 >= x1 || y0 >= y1) return 0;
+
+    level = std::min(level, topLevel_);
+    if (level >= FIRST_PYRAMID_LEVEL && pyramidStale_) buildPyramid(maze);
+
+    size_t rebuilt = 0;
+    for (int ty = (y0 >> level) / TILE_SIZE; ty <= ((y1 - 1) >> level) / TILE_SIZE; ++ty) {
+        for (int tx = (x0 >> level) / TILE_SIZE; tx <= ((x1 - 1) >> level) / TILE_SIZE; ++tx) {
+            Tile& tile = tiles_[tileKey(level, tx, ty)];
+            tile.lastUsed = frame_;
+            if (!tile.dirty) continue;
+            rebuild(maze, level, tx, ty, tile);
+            ++rebuilt;
+        }
+    }
+    evict();
+    return rebuilt;
+}
+
+void MazeRenderer::resize(int width, int height) {
+    width_ = width;
+    height_ = height;
+    topLevel_ = 0;
+    while (topLevel_ < MAX_LEVEL && (levelSize(width, topLevel_) > 1 || levelSize(height, topLevel_) > 1)) {
+        ++topLevel_;
+    }
+    tiles_.clear();
+    pyramid_.clear();
+    pyramidStale_ = true;
+    pixels_.resize(static_cast<size_t>(TILE_SIZE) * TILE_SIZE * 4);
+}
+
+void MazeRenderer::rebuild(const Maze& maze, int level, int tx, int ty, Tile& tile) {
+    const int x0 = tx * TILE_SIZE;
+    const int y0 = ty * TILE_SIZE;
+    const int width = std::min(TILE_SIZE, levelSize(width_, level) - x0);
+    const int height = std::min(TILE_SIZE, levelSize(height_, level) - y0);
+    if (tile.texture.getSize() != sf::Vector2u(width, height)) {
+        tile.texture.create(width, height);
+    }
+
+    std::uint8_t* pixel = pixels_.data();
+    for (int y = y0; y < y0 + height; ++y) {
+        for (int x = x0; x < x0 + width; ++x) {
+            const sf::Color color = level == 0 ? colorOf(maze.getCellType(x, y)) : shade(blockAt(maze, level, x, y));
+            *pixel++ = color.r;
+            *pixel++ = color.g;
+            *pixel++ = color.b;
+            *pixel++ = color.a;
+        }
+    }
+    tile.texture.update(pixels_.data(), width, height, 0, 0);
+    tile.dirty = false;
+}
+
+// Drops the least recently drawn tiles past the cache size, never one in
+// use this frame
+void MazeRenderer::evict() {
+    if (tiles_.size() <= MAX_TILES) return;
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> unused;  // last used, key
+    for (const auto& entry : tiles_) {
+        if (entry.second.lastUsed != frame_) unused.emplace_back(entry.second.lastUsed, entry.first);
+    }
+    std::sort(unused.begin(), unused.end());
+    for (size_t i = 0; i < unused.size() && tiles_.size() > MAX_TILES; ++i) {
+        tiles_.erase(unused[i].second);
+    }
+}
+
+MazeRenderer::Block MazeRenderer::blockAt(const Maze& maze, int level, int x, int y) const {
+    if (level < FIRST_PYRAMID_LEVEL) return summarizeCells(maze, x << level, y << level, 1 << level);
+    return pyramid_[level][static_cast<size_t>(y) * levelSize(width_, level) + x];
+}
+
+MazeRenderer::Block MazeRenderer::summarizeCells(const Maze& maze, int x0, int y0, int size) const {
+    int walls = 0, visited = 0, count = 0;
+    Block block;
+    for (int y = y0; y < std::min(y0 + size, height_); ++y) {
+        for (int x = x0; x < std::min(x0 + size, width_); ++x) {
+            ++count;
+            switch (maze.getCellType(x, y)) {
+                case Maze::CellType::WALL: ++walls; break;
+                case Maze::CellType::VISITED: ++visited; break;
+                case Maze::CellType::PATH_FOUND: ++visited; block.flags |= HAS_PATH; break;
+                case Maze::CellType::START: block.flags |= HAS_START; break;
+                case Maze::CellType::GOAL: block.flags |= HAS_GOAL; break;
+                default: break;
+            }
+        }
+    }
+    if (count > 0) {
+        block.walls = static_cast<std::uint8_t>(walls * 255 / count);
+        block.visited = static_cast<std::uint8_t>(visited * 255 / count);
+    }
+    return block;
+}
+
+// Children past the edge of the maze do not count towards the averages
+MazeRenderer::Block MazeRenderer::summarizeChildren(int level, int x, int y) const {
+    const std::vector<Block>& below = pyramid_[level - 1];
+    const int belowWidth = levelSize(width_, level - 1);
+    const int belowHeight = levelSize(height_, level - 1);
+    int walls = 0, visited = 0, count = 0;
+    Block block;
+    for (int cy = 2 * y; cy < std::min(2 * y + 2, belowHeight); ++cy) {
+        for (int cx = 2 * x; cx < std::min(2 * x + 2, belowWidth); ++cx) {
+            const Block& child = below[static_cast<size_t>(cy) * belowWidth + cx];
+            walls += child.walls;
+            visited += child.visited;
+            block.flags |= child.flags;
+            ++count;
+        }
+    }
+    if (count > 0) {
+        block.walls = static_cast<std::uint8_t>(walls / count);
+        block.visited = static_cast<std::uint8_t>(visited / count);
+    }
+    return block;
+}
+
+void MazeRenderer::buildPyramid(const Maze& maze) {
+    pyramid_.assign(topLevel_ + 1, std::vector<Block>());
+    for (int level = FIRST_PYRAMID_LEVEL; level <= topLevel_; ++level) {
+        const int width = levelSize(width_, level);
+        const int height = levelSize(height_, level);
+        std::vector<Block>& blocks = pyramid_[level];
+        blocks.resize(static_cast<size_t>(width) * height);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                blocks[static_cast<size_t>(y) * width + x] =
+                    level == FIRST_PYRAMID_LEVEL ? summarizeCells(maze, x << level, y << level, 1 << level)
+                                                 : summarizeChildren(level, x, y);
+            }
+        }
+    }
+    pyramidStale_ = false;
+}
+
+// Re-summarises the blocks holding one changed cell, bottom up
+void MazeRenderer::patchPyramid(const Maze& maze, int cell) {
+    const int x = cell % width_;
+    const int y = cell / width_;
+    for (int level = FIRST_PYRAMID_LEVEL; level <= topLevel_; ++level) {
+        const int bx = x >> level;
+        const int by = y >> level;
+        pyramid_[level][static_cast<size_t>(by) * levelSize(width_, level) + bx] =
+            level == FIRST_PYRAMID_LEVEL ? summarizeCells(maze, bx << level, by << level, 1 << level)
+                                         : summarizeChildren(level, bx, by);
+    }
+}
+
+// Start, goal and path win over the block's mix of walls, visited and
+// open cells
+sf::Color MazeRenderer::shade(const Block& block) const {
+    if (block.flags & HAS_GOAL) return colorOf(Maze::CellType::GOAL);
+    if (block.flags & HAS_START) return colorOf(Maze::CellType::START);
+    if (block.flags & HAS_PATH) return colorOf(Maze::CellType::PATH_FOUND);
+
+    const int walls = block.walls;
+    const int visited = std::min<int>(block.visited, 255 - walls);
+    const int open = 255 - walls - visited;
+    auto mix = [&](std::uint8_t visitedChannel) {
+        return static_cast<std::uint8_t>((visited * visitedChannel + open * 255) / 255);
+    };
+    return sf::Color(mix(visitedColor_.r), mix(visitedColor_.g), mix(visitedColor_.b));
+}
@@ -1,13 +1,31 @@
 #include "../include/Maze.hpp"
+#include "../include/MazeRenderer.hpp"
 #include "../include/pathfinders/AStar.hpp"
 #include "../include/pathfinders/Dijkstra.hpp"
+#include "../include/pathfinders/BucketDijkstra.hpp"
 #include "../include/pathfinders/BFS.hpp"
 #include "../include/pathfinders/DFS.hpp"
 #include "../include/pathfinders/GreedyBestFirst.hpp"
 #include "../include/pathfinders/JPS.hpp"
+#include "../include/pathfinders/JPSPlus.hpp"
+#include "../include/pathfinders/HPAStar.hpp"
+#include "../include/pathfinders/DStarLite.hpp"
+#include "../include/pathfinders/ParallelBFS.hpp"
+#include "../include/pathfinders/BitWavefront.hpp"
+#include "../include/pathfinders/FlowField.hpp"
+#include "../include/pathfinders/Bidirectional.hpp"
+#include "../include/pathfinders/ALT.hpp"
+#include "../include/pathfinders/ARAStar.hpp"
+#include "../include/BatchExecutor.hpp"
+#include "../include/SteppedSearch.hpp"
+#include "../include/TraceReplay.hpp"
+#include <cstdio>
 #include <cassert>
+#include <cmath>
 #include <iostream>
 #include <memory>
+#include <random>
+#include <algorithm>
 #include <vector>
 
 class TestRunner {
@@ -19,6 +37,31 @@ public:
         testNoPath();
         testLargeMaze();
         testEmptyMaze();
+        testSearchOverlay();
+        testBatchedEdits();
+        testRepeatedQueries();
+        testOpenLists();
+        testBucketQueues();
+        testSearchPolicies();
+        testNeighborMasks();
+        testIntegerCosts();
+        testJumpPointSearch();
+        testJumpTables();
+        testHierarchicalSearch();
+        testIncrementalReplanning();
+        testComponentIndex();
+        testParallelBFS();
+        testBitWavefront();
+        testBatchQueries();
+        testFlowFields();
+        testBidirectionalSearch();
+        testLandmarks();
+        testAnytimeSearch();
+        testSearchLimits();
+        testSteppedSearch();
+        testSearchTraces();
+        testDirtyRendering();
+        testLevelOfDetail();
         
         std::cout << "All tests passed!\n";
     }
@@ -50,6 +93,18 @@ private:
         testAlgorithm<DFS>(maze, true);
         testAlgorithm<GreedyBestFirst>(maze, true);
         testAlgorithm<JPS>(maze, true);
+        testAlgorithm<AStarOctile>(maze, true);
+        testAlgorithm<JPSOctile>(maze, true);
+        testAlgorithm<JPSPlus>(maze, true);
+        testAlgorithm<HPAStar>(maze, true);
+        testAlgorithm<DStarLite>(maze, true);
+        testAlgorithm<ParallelBFS>(maze, true);
+        testAlgorithm<BitWavefront>(maze, true);
+        testAlgorithm<FlowFieldPathfinder>(maze, true);
+        testAlgorithm<BidirectionalBFS>(maze, true);
+        testAlgorithm<BidirectionalAStar>(maze, true);
+        testAlgorithm<ALTAStar>(maze, true);
+        testAlgorithm<ARAStar>(maze, true);
 
         std::cout << "PASSED\n";
     }
@@ -77,6 +132,18 @@ private:
         testAlgorithm<DFS>(maze, false);
         testAlgorithm<GreedyBestFirst>(maze, false);
         testAlgorithm<JPS>(maze, false);
+        testAlgorithm<AStarOctile>(maze, false);
+        testAlgorithm<JPSOctile>(maze, false);
+        testAlgorithm<JPSPlus>(maze, false);
+        testAlgorithm<HPAStar>(maze, false);
+        testAlgorithm<DStarLite>(maze, false);
+        testAlgorithm<ParallelBFS>(maze, false);
+        testAlgorithm<BitWavefront>(maze, false);
+        testAlgorithm<FlowFieldPathfinder>(maze, false);
+        testAlgorithm<BidirectionalBFS>(maze, false);
+        testAlgorithm<BidirectionalAStar>(maze, false);
+        testAlgorithm<ALTAStar>(maze, false);
+        testAlgorithm<ARAStar>(maze, false);
 
         std::cout << "PASSED\n";
     }
@@ -89,6 +156,10 @@ private:
         maze.resize(100, 100);
         maze.generateRandom(100, 100, 0.3);
 
+        // Keep an L-shaped corridor open so the random maze is always solvable
+        maze.fillRect(Maze::Rect(1, 0, 98, 1), Maze::CellType::PATH);
+        maze.fillRect(Maze::Rect(99, 0, 1, 99), Maze::CellType::PATH);
+
         // Test each algorithm
         testAlgorithm<AStarEuclidean>(maze, true);
         testAlgorithm<Dijkstra>(maze, true);
@@ -96,6 +167,18 @@ private:
         testAlgorithm<DFS>(maze, true);
         testAlgorithm<GreedyBestFirst>(maze, true);
         testAlgorithm<JPS>(maze, true);
+        testAlgorithm<AStarOctile>(maze, true);
+        testAlgorithm<JPSOctile>(maze, true);
+        testAlgorithm<JPSPlus>(maze, true);
+        testAlgorithm<HPAStar>(maze, true);
+        testAlgorithm<DStarLite>(maze, true);
+        testAlgorithm<ParallelBFS>(maze, true);
+        testAlgorithm<BitWavefront>(maze, true);
+        testAlgorithm<FlowFieldPathfinder>(maze, true);
+        testAlgorithm<BidirectionalBFS>(maze, true);
+        testAlgorithm<BidirectionalAStar>(maze, true);
+        testAlgorithm<ALTAStar>(maze, true);
+        testAlgorithm<ARAStar>(maze, true);
 
         std::cout << "PASSED\n";
     }
@@ -118,10 +201,1317 @@ private:
         testAlgorithm<DFS>(maze, true);
         testAlgorithm<GreedyBestFirst>(maze, true);
         testAlgorithm<JPS>(maze, true);
+        testAlgorithm<AStarOctile>(maze, true);
+        testAlgorithm<JPSOctile>(maze, true);
+        testAlgorithm<JPSPlus>(maze, true);
+        testAlgorithm<HPAStar>(maze, true);
+        testAlgorithm<DStarLite>(maze, true);
+        testAlgorithm<ParallelBFS>(maze, true);
+        testAlgorithm<BitWavefront>(maze, true);
+        testAlgorithm<FlowFieldPathfinder>(maze, true);
+        testAlgorithm<BidirectionalBFS>(maze, true);
+        testAlgorithm<BidirectionalAStar>(maze, true);
+        testAlgorithm<ALTAStar>(maze, true);
+        testAlgorithm<ARAStar>(maze, true);
+
+        std::cout << "PASSED\n";
+    }
+
+    void testSearchOverlay() {
+        std::cout << "Testing search overlay... ";
+
+        Maze maze;
+        maze.resize(4, 4);
+        maze.setCellType(1, 1, Maze::CellType::WALL);
+        maze.setCellType(0, 0, Maze::CellType::START);
+
+        // Overlay cells are drawn on top but never change the terrain
+        maze.setCellType(2, 2, Maze::CellType::VISITED);
+        maze.setOverlay(3, 3, Maze::CellType::PATH_FOUND);
+        maze.setOverlay(0, 0, Maze::CellType::VISITED);
+        assert(maze.getCellType(2, 2) == Maze::CellType::VISITED);
+        assert(maze.getCellType(3, 3) == Maze::CellType::PATH_FOUND);
+        assert(maze.getCellType(0, 0) == Maze::CellType::START);
+        assert(maze.getTerrain(2, 2) == Maze::CellType::PATH);
+        assert(maze.isWalkable(2, 2) && !maze.isWalkable(1, 1));
+
+        maze.clearOverlay();
+        assert(maze.getCellType(2, 2) == Maze::CellType::PATH);
+        assert(maze.getCellType(3, 3) == Maze::CellType::PATH);
+        assert(maze.getStart() == Maze::Point(0, 0));
+
+        std::cout << "PASSED\n";
+    }
+
+    void testBatchedEdits() {
+        std::cout << "Testing batched edits... ";
+
+        Maze maze;
+        maze.resize(8, 8);
+        maze.setCellType(0, 0, Maze::CellType::START);
+        maze.setCellType(7, 7, Maze::CellType::GOAL);
+
+        // Moving the start demotes the old start cell without a rescan
+        maze.setCellType(2, 0, Maze::CellType::START);
+        assert(maze.getStart() == Maze::Point(2, 0));
+        assert(maze.getTerrain(0, 0) == Maze::CellType::PATH);
+
+        // A batch reports one bounding box and bumps the revision once
+        auto revision = maze.getRevision();
+        maze.beginEdit();
+        maze.setCellType(1, 1, Maze::CellType::WALL);
+        maze.fillRect(Maze::Rect(2, 3, 2, 2), Maze::CellType::WALL);
+        Maze::Rect dirty = maze.commit();
+        assert(dirty.x == 1 && dirty.y == 1 && dirty.width == 3 && dirty.height == 4);
+        assert(maze.getRevision() == revision + 1);
+        assert(!maze.isWalkable(3, 4) && maze.isWalkable(4, 4));
+
+        // Rewriting identical terrain reports nothing
+        maze.beginEdit();
+        maze.setCellType(1, 1, Maze::CellType::WALL);
+        assert(maze.commit().empty());
+        assert(maze.getRevision() == revision + 1);
+
+        std::cout << "PASSED\n";
+    }
+
+    void testRepeatedQueries() {
+        std::cout << "Testing repeated queries... ";
+
+        // One instance reuses its search state across mazes and endpoints
+        Dijkstra dijkstra;
+        Maze maze;
+        maze.resize(20, 20);
+        maze.setCellType(0, 0, Maze::CellType::START);
+        maze.setCellType(19, 19, Maze::CellType::GOAL);
+        assert(dijkstra.findPath(maze).pathLength == 20);
+
+        maze.setCellType(5, 0, Maze::CellType::GOAL);
+        assert(dijkstra.findPath(maze).pathLength == 6);
+
+        Maze small;
+        small.resize(3, 1);
+        small.setCellType(0, 0, Maze::CellType::START);
+        small.setCellType(2, 0, Maze::CellType::GOAL);
+        assert(dijkstra.findPath(small).pathLength == 3);
+
+        small.setCellType(1, 0, Maze::CellType::WALL);
+        assert(dijkstra.findPath(small).path.empty());
+
+        std::cout << "PASSED\n";
+    }
+
+    void testOpenLists() {
+        std::cout << "Testing open lists... ";
+
+        testOpenList<QuadHeap<double>>();
+        testOpenList<PairingHeap<double>>();
+
+        // The indexed heap also raises keys and removes from the middle
+        QuadHeap<int> heap;
+        heap.reset(8);
+        for (int i = 0; i < 6; ++i) heap.push(i, 10 + i);
+        heap.update(0, 20);
+        heap.erase(2);
+        heap.update(5, 1);
+        assert(heap.pop() == 5 && heap.pop() == 1 && heap.pop() == 3 && heap.pop() == 4 && heap.pop() == 0);
+        assert(heap.empty() && !heap.contains(2));
+
+        // Both heaps drive the same searches to paths of the same length, and
+        // no cell is expanded more than once
+        Maze maze;
+        maze.resize(60, 60);
+        maze.generateRandom(60, 60, 0.25f);
+        maze.fillRect(Maze::Rect(1, 0, 58, 1), Maze::CellType::PATH);
+        maze.fillRect(Maze::Rect(59, 0, 1, 59), Maze::CellType::PATH);
+
+        AStarEuclidean quadAStar;
+        AStarPairing pairingAStar;
+        auto quadResult = quadAStar.findPath(maze);
+        auto pairingResult = pairingAStar.findPath(maze);
+        assert(std::abs(pathCost(quadResult.path) - pathCost(pairingResult.path)) < 1e-9);
+        assert(quadResult.nodesExplored <= 60 * 60);
+
+        Dijkstra quadDijkstra;
+        DijkstraPairing pairingDijkstra;
+        assert(quadDijkstra.findPath(maze).pathLength == pairingDijkstra.findPath(maze).pathLength);
+
+        std::cout << "PASSED\n";
+    }
+
+    template<typename OpenList>
+    void testOpenList() {
+        OpenList open;
+        open.reset(16);
+        open.push(3, 5.0);
+        open.push(7, 2.0);
+        open.push(9, 8.0);
+        open.push(1, 4.0);
+        assert(open.contains(9) && !open.contains(2));
+
+        open.decreaseKey(9, 1.0);
+        open.pushOrDecrease(3, 0.5);
+        assert(open.size() == 4);
+        assert(open.pop() == 3);
+        assert(open.pop() == 9);
+        assert(open.pop() == 7);
+        assert(open.pop() == 1);
+        assert(open.empty() && !open.contains(1));
+
+        // Reset leaves nothing behind from a query that stopped early
+        open.push(5, 1.0);
+        open.reset(16);
+        assert(open.empty() && !open.contains(5));
+    }
+
+    void testBucketQueues() {
+        std::cout << "Testing bucket queues... ";
+
+        testMonotoneQueue<BucketQueue<int, OctileCost::MAX_STEP>>();
+        testMonotoneQueue<RadixHeap<int>>();
+
+        Maze maze;
+        maze.resize(60, 60);
+        maze.generateRandom(60, 60, 0.25f);
+        maze.fillRect(Maze::Rect(1, 0, 58, 1), Maze::CellType::PATH);
+        maze.fillRect(Maze::Rect(59, 0, 1, 59), Maze::CellType::PATH);
+
+        // Dial's buckets give the same unit-cost distances as the heap
+        Dijkstra dijkstra;
+        DialDijkstra dial;
+        assert(dial.findPath(maze).pathLength == dijkstra.findPath(maze).pathLength);
+
+        // The radix heap finds octile-optimal paths, same as a plain heap
+        RadixDijkstra radix;
+        IntegerDijkstra<QuadHeap<int>, OctileCost> reference("reference");
+        assert(octileCost(radix.findPath(maze).path) == octileCost(reference.findPath(maze).path));
+
+        testAlgorithm<DialDijkstra>(maze, true);
+        testAlgorithm<RadixDijkstra>(maze, true);
+
+        std::cout << "PASSED\n";
+    }
+
+    void testSearchPolicies() {
+        std::cout << "Testing search policies... ";
+
+        Maze maze;
+        maze.resize(60, 60);
+        maze.generateRandom(60, 60, 0.25f);
+        maze.fillRect(Maze::Rect(1, 0, 58, 1), Maze::CellType::PATH);
+        maze.fillRect(Maze::Rect(59, 0, 1, 59), Maze::CellType::PATH);
+
+        // A 4-connected A* composed from policies finds BFS-length paths
+        BestFirstSearch<FourNeighborhood, EuclideanHeuristic, UnitCost, QuadHeap<int>> astar4("A* (4-connected)");
+        BFS bfs;
+        auto result = astar4.findPath(maze);
+        assert(result.pathLength == bfs.findPath(maze).pathLength);
+        for (size_t i = 1; i < result.path.size(); ++i) {
+            assert(std::abs(result.path[i].x - result.path[i - 1].x) +
+                   std::abs(result.path[i].y - result.path[i - 1].y) == 1);
+        }
+
+        // Octile A* agrees with the octile Dijkstra reference
+        BestFirstSearch<EightNeighborhood, OctileHeuristic, OctileCost, QuadHeap<int>> octile("A* (octile)");
+        IntegerDijkstra<QuadHeap<int>, OctileCost> reference("reference");
+        assert(octileCost(octile.findPath(maze).path) == octileCost(reference.findPath(maze).path));
+
+        std::cout << "PASSED\n";
+    }
+
+    void testNeighborMasks() {
+        std::cout << "Testing neighbor masks... ";
+
+        Maze maze;
+        maze.generateRandom(30, 20, 0.3f);
+        checkNeighborMasks(maze);
+
+        // Single edits, a batch and a resize all keep the masks current
+        maze.setCellType(0, 0, Maze::CellType::WALL);
+        maze.setCellType(5, 5, Maze::CellType::PATH);
+        checkNeighborMasks(maze);
+        maze.beginEdit();
+        maze.fillRect(Maze::Rect(10, 10, 4, 3), Maze::CellType::WALL);
+        maze.setCellType(29, 19, Maze::CellType::PATH);
+        maze.commit();
+        checkNeighborMasks(maze);
+        maze.resize(7, 9);
+        checkNeighborMasks(maze);
+
+        std::cout << "PASSED\n";
+    }
+
+    void testIntegerCosts() {
+        std::cout << "Testing integer octile costs... ";
+
+        Maze maze;
+        maze.generateRandom(60, 60, 0.25f);
+        maze.fillRect(Maze::Rect(1, 0, 58, 1), Maze::CellType::PATH);
+        maze.fillRect(Maze::Rect(59, 0, 1, 59), Maze::CellType::PATH);
+
+        // Integer A* and JPS are octile-optimal
+        AStarOctile astar;
+        JPSOctile jps;
+        IntegerDijkstra<QuadHeap<int>, OctileCost> reference("reference");
+        int optimal = octileCost(reference.findPath(maze).path);
+        assert(octileCost(astar.findPath(maze).path) == optimal);
+        assert(octileCost(jps.findPath(maze).path) == optimal);
+
+        // On an open map, preferring larger g expands only the cells on one path
+        Maze open;
+        open.resize(40, 40);
+        open.setCellType(0, 0, Maze::CellType::START);
+        open.setCellType(39, 25, Maze::CellType::GOAL);
+        auto result = astar.findPath(open);
+        assert(result.nodesExplored == result.pathLength);
 
         std::cout << "PASSED\n";
     }
 
+    void testJumpPointSearch() {
+        std::cout << "Testing jump point search... ";
+
+        // Widths around the 64-cell word size exercise the block scans at
+        // word boundaries in both directions
+        for (int width : {3, 63, 64, 65, 130}) {
+            Maze maze;
+            maze.generateRandom(width, 40, 0.3f);
+            maze.setCellType(width - 1, 0, Maze::CellType::START);
+            maze.setCellType(0, 39, Maze::CellType::GOAL);
+
+            JPSOctile jps;
+            IntegerDijkstra<QuadHeap<int>, OctileCost> reference("reference");
+            auto expected = reference.findPath(maze);
+            auto result = jps.findPath(maze);
+            assert(result.path.empty() == expected.path.empty());
+            assert(octileCost(result.path) == octileCost(expected.path));
+        }
+
+        // Long open runs no longer recurse once per cell
+        Maze open;
+        open.resize(1500, 1500);
+        open.setCellType(0, 0, Maze::CellType::START);
+        open.setCellType(1499, 1200, Maze::CellType::GOAL);
+        testAlgorithm<JPS>(open, true);
+
+        std::cout << "PASSED\n";
+    }
+
+    void testJumpTables() {
+        std::cout << "Testing jump tables... ";
+
+        Maze maze;
+        maze.generateRandom(90, 70, 0.3f);
+        IntegerDijkstra<QuadHeap<int>, OctileCost> reference("reference");
+        JPSPlus jpsPlus;
+        jpsPlus.prepare(maze);
+
+        // Moving the endpoints keeps the table; each query stays optimal
+        auto stamp = maze.getWalkabilityStamp();
+        for (int i = 0; i < 10; ++i) {
+            if (!maze.isWalkable(i * 7, i * 3) || !maze.isWalkable(89 - i * 5, 69 - i * 2)) continue;
+            maze.setCellType(i * 7, i * 3, Maze::CellType::START);
+            maze.setCellType(89 - i * 5, 69 - i * 2, Maze::CellType::GOAL);
+            assert(octileCost(jpsPlus.findPath(maze).path) == octileCost(reference.findPath(maze).path));
+        }
+        assert(maze.getWalkabilityStamp() == stamp);
+
+        // Saved tables reload through a mapping and answer the same queries
+        const std::string mazePath = "test_jump_table.png";
+        JumpTable saved;
+        assert(saved.save(maze, mazePath));
+        JumpTable loaded;
+        assert(loaded.load(maze, mazePath));
+        for (int y = 0; y < maze.getHeight(); ++y) {
+            for (int x = 0; x < maze.getWidth(); ++x) {
+                if (!maze.isWalkable(x, y)) continue;
+                for (int d = 0; d < Maze::DIRECTION_COUNT; ++d) {
+                    int dx = Maze::DIRECTION_DX[d];
+                    int dy = Maze::DIRECTION_DY[d];
+                    assert(loaded.jump(maze, Maze::Point(x, y), dx, dy, maze.getGoal()) ==
+                           saved.jump(maze, Maze::Point(x, y), dx, dy, maze.getGoal()));
+                }
+            }
+        }
+
+        // A table for different walls is rejected
+        maze.setCellType(45, 35, maze.isWalkable(45, 35) ? Maze::CellType::WALL : Maze::CellType::PATH);
+        assert(maze.getWalkabilityStamp() != stamp);
+        JumpTable stale;
+        assert(!stale.load(maze, mazePath));
+        std::remove(JumpTable::tablePath(mazePath).c_str());
+
+        // Edits invalidate the prepared table
+        assert(octileCost(jpsPlus.findPath(maze).path) == octileCost(reference.findPath(maze).path));
+
+        std::cout << "PASSED\n";
+    }
+
+    void testHierarchicalSearch() {
+        std::cout << "Testing hierarchical search... ";
+
+        Maze maze;
+        maze.generateRandom(150, 120, 0.25f);
+        maze.fillRect(Maze::Rect(1, 0, 148, 1), Maze::CellType::PATH);
+        maze.fillRect(Maze::Rect(149, 0, 1, 119), Maze::CellType::PATH);
+        IntegerDijkstra<QuadHeap<int>, OctileCost> reference("reference");
+
+        // Clusters stay small enough for 16-bit component labels
+        assert(HPAStar(1000).getName() == HPAStar(255).getName());
+
+        HPAStar hpa(16);
+
+        for (int i = 0; i < 6; ++i) {
+            // Single-cell edits rebuild a few clusters, not the whole hierarchy
+            if (i > 0) {
+                int x = 20 + i * 19;
+                int y = 15 + i * 13;
+                maze.setCellType(x, y, maze.isWalkable(x, y) ? Maze::CellType::WALL : Maze::CellType::PATH);
+            }
+            auto result = hpa.findPath(maze);
+            if (i > 0) assert(hpa.getLastRebuildCount() > 0 && hpa.getLastRebuildCount() <= 9);
+            testAlgorithm<HPAStar>(maze, true);
+
+            // Paths stay close to optimal, and an updated hierarchy matches
+            // one built from scratch
+            HPAStar fresh(16);
+            auto expected = reference.findPath(maze);
+            assert(octileCost(result.path) <= octileCost(expected.path) * 5 / 4);
+            assert(octileCost(fresh.findPath(maze).path) == octileCost(result.path));
+            assert(fresh.getEntranceCount() == hpa.getEntranceCount());
+        }
+
+        // Queries that only move the endpoints reuse the hierarchy
+        maze.setCellType(1, 0, Maze::CellType::START);
+        hpa.findPath(maze);
+        assert(hpa.getLastRebuildCount() == 0);
+
+        std::cout << "PASSED\n";
+    }
+
+    void testIncrementalReplanning() {
+        std::cout << "Testing incremental replanning... ";
+
+        Maze maze;
+        maze.generateRandom(120, 90, 0.25f);
+        maze.fillRect(Maze::Rect(1, 0, 118, 1), Maze::CellType::PATH);
+        maze.fillRect(Maze::Rect(119, 0, 1, 89), Maze::CellType::PATH);
+        IntegerDijkstra<QuadHeap<int>, OctileCost> reference("reference");
+        DStarLite planner;
+
+        auto initial = planner.findPath(maze);
+        assert(!planner.lastRunWasRepair());
+        assert(octileCost(initial.path) == octileCost(reference.findPath(maze).path));
+
+        // Drive along the path, discovering a wall a few cells ahead each
+        // step; the repairs together cost less than planning every step anew
+        std::vector<Maze::Point> path = initial.path;
+        size_t repaired = 0;
+        size_t fromScratch = 0;
+        for (int step = 0; step < 15 && path.size() > 6; ++step) {
+            maze.setCellType(path[1].x, path[1].y, Maze::CellType::START);
+            maze.setCellType(path[5].x, path[5].y, Maze::CellType::WALL);
+            if (!maze.areConnected(maze.getStart(), maze.getGoal())) {
+                // Cut off goals are rejected before D* Lite even runs
+                maze.setCellType(path[5].x, path[5].y, Maze::CellType::PATH);
+            }
+
+            auto result = planner.findPath(maze);
+            assert(planner.lastRunWasRepair());
+            assert(octileCost(result.path) == octileCost(reference.findPath(maze).path));
+            repaired += result.nodesExplored;
+            fromScratch += DStarLite().findPath(maze).nodesExplored;
+            path = result.path;
+        }
+        assert(repaired < fromScratch);
+
+        // Clearing cells lowers costs again
+        maze.fillRect(Maze::Rect(40, 30, 20, 20), Maze::CellType::PATH);
+        assert(octileCost(planner.findPath(maze).path) == octileCost(reference.findPath(maze).path));
+        assert(planner.lastRunWasRepair());
+
+        // A new goal starts over
+        maze.setCellType(119, 0, Maze::CellType::GOAL);
+        assert(octileCost(planner.findPath(maze).path) == octileCost(reference.findPath(maze).path));
+        assert(!planner.lastRunWasRepair());
+
+        std::cout << "PASSED\n";
+    }
+
+    void testComponentIndex() {
+        std::cout << "Testing component index... ";
+
+        // A wall across the grid splits it, and unreachable goals are
+        // rejected without exploring anything
+        Maze maze;
+        maze.resize(30, 20);
+        maze.setCellType(0, 0, Maze::CellType::START);
+        maze.setCellType(29, 19, Maze::CellType::GOAL);
+        maze.fillRect(Maze::Rect(10, 0, 1, 20), Maze::CellType::WALL);
+        assert(!maze.areConnected(maze.getStart(), maze.getGoal()));
+        assert(maze.getComponent(10, 5) == Maze::NO_COMPONENT);
+        assert(AStarOctile().findPath(maze).nodesExplored == 0);
+        assert(JPSPlus().findPath(maze).nodesExplored == 0);
+        assert(DStarLite().findPath(maze).nodesExplored == 0);
+        checkComponents(maze);
+
+        // Opening one cell merges them again, and closing it splits them
+        maze.setCellType(10, 7, Maze::CellType::PATH);
+        assert(maze.areConnected(maze.getStart(), maze.getGoal()));
+        maze.setCellType(10, 7, Maze::CellType::WALL);
+        assert(!maze.areConnected(maze.getStart(), maze.getGoal()));
+        maze.fillRect(Maze::Rect(9, 4, 3, 3), Maze::CellType::PATH);
+        assert(maze.areConnected(maze.getStart(), maze.getGoal()));
+        checkComponents(maze);
+
+        // Random edits, single cells and blocks, keep the index exact
+        maze.generateRandom(80, 60, 0.35f);
+        checkComponents(maze);
+        std::mt19937 rng(7);
+        for (int i = 0; i < 150; ++i) {
+            int x = static_cast<int>(rng() % 80);
+            int y = static_cast<int>(rng() % 60);
+            Maze::CellType type = rng() % 2 ? Maze::CellType::WALL : Maze::CellType::PATH;
+            if (i % 5 == 0) {
+                maze.fillRect(Maze::Rect(x, y, 1 + static_cast<int>(rng() % 6), 1 + static_cast<int>(rng() % 6)), type);
+            } else {
+                maze.setCellType(x, y, type);
+            }
+            checkComponents(maze);
+        }
+
+        std::cout << "PASSED\n";
+    }
+
+    void testParallelBFS() {
+        std::cout << "Testing parallel BFS... ";
+
+        // Paths are as short as those of the sequential BFS, whatever the
+        // number of threads
+        Maze maze;
+        maze.generateRandom(300, 200, 0.25f);
+        maze.fillRect(Maze::Rect(1, 0, 298, 1), Maze::CellType::PATH);
+        maze.fillRect(Maze::Rect(299, 0, 1, 199), Maze::CellType::PATH);
+        const size_t expected = BFS().findPath(maze).path.size();
+        for (unsigned threads : {1u, 2u, 3u}) {
+            ParallelBFS search(threads);
+            for (int query = 0; query < 2; ++query) {
+                auto result = search.findPath(maze);
+                assert(result.path.size() == expected);
+                for (size_t i = 1; i < result.path.size(); ++i) {
+                    assert(std::abs(result.path[i].x - result.path[i - 1].x) +
+                           std::abs(result.path[i].y - result.path[i - 1].y) == 1);
+                    assert(maze.isWalkable(result.path[i].x, result.path[i].y));
+                }
+            }
+        }
+
+        // An open map grows a frontier wide enough to switch to bottom-up
+        maze.resize(400, 400);
+        maze.setCellType(200, 200, Maze::CellType::START);
+        maze.setCellType(399, 399, Maze::CellType::GOAL);
+        ParallelBFS search(2);
+        assert(search.findPath(maze).path.size() == BFS().findPath(maze).path.size());
+        assert(search.getBottomUpLevels() > 0);
+
+        std::cout << "PASSED\n";
+    }
+
+    void testBitWavefront() {
+        std::cout << "Testing bitboard wavefront... ";
+
+        // Layers match BFS on grids narrower and wider than a word, with
+        // endpoints anywhere, and the walk back stays on walkable cells
+        std::mt19937 rng(11);
+        for (int i = 0; i < 40; ++i) {
+            Maze maze;
+            int width = 2 + static_cast<int>(rng() % 200);
+            int height = 2 + static_cast<int>(rng() % 120);
+            maze.generateRandom(width, height, 0.05f * (i % 9));
+            maze.setCellType(static_cast<int>(rng() % width), static_cast<int>(rng() % height), Maze::CellType::START);
+            maze.setCellType(static_cast<int>(rng() % width), static_cast<int>(rng() % height), Maze::CellType::GOAL);
+
+            auto expected = BFS().findPath(maze);
+            auto result = BitWavefront().findPath(maze);
+            assert(result.path.size() == expected.path.size());
+            if (result.path.empty()) continue;
+            assert(result.path.front() == maze.getStart() && result.path.back() == maze.getGoal());
+            for (size_t j = 1; j < result.path.size(); ++j) {
+                assert(std::abs(result.path[j].x - result.path[j - 1].x) +
+                       std::abs(result.path[j].y - result.path[j - 1].y) == 1);
+                assert(maze.isWalkable(result.path[j].x, result.path[j].y));
+            }
+        }
+
+        std::cout << "PASSED\n";
+    }
+
+    void testBatchQueries() {
+        std::cout << "Testing batch queries... ";
+
+        // Every index runs exactly once, however unevenly the work is spread
+        WorkStealingPool pool(3);
+        std::vector<std::atomic<int>> runs(1000);
+        pool.run(runs.size(), [&](size_t index, unsigned worker) {
+            assert(worker < pool.size());
+            if (index < 10) std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            runs[index].fetch_add(1);
+        });
+        for (const std::atomic<int>& count : runs) assert(count.load() == 1);
+
+        // Explicit endpoints leave the maze's own start and goal alone
+        Maze maze;
+        maze.generateRandom(120, 90, 0.25f);
+        std::vector<Maze::Point> cells;
+        for (int y = 0; y < maze.getHeight(); ++y) {
+            for (int x = 0; x < maze.getWidth(); ++x) {
+                if (maze.isWalkable(x, y)) cells.push_back(Maze::Point(x, y));
+            }
+        }
+        std::mt19937 rng(5);
+        std::vector<BatchExecutor::Query> queries;
+        for (int i = 0; i < 300; ++i) {
+            queries.push_back({cells[rng() % cells.size()], cells[rng() % cells.size()]});
+        }
+        AStarOctile sequential;
+        auto single = sequential.findPath(maze, queries[0].start, queries[0].goal);
+        assert(maze.getStart() == Maze::Point(0, 0));
+        if (!single.path.empty()) {
+            assert(single.path.front() == queries[0].start && single.path.back() == queries[0].goal);
+        }
+
+        // A batch over several workers answers like one pathfinder would
+        BatchExecutor executor([] { return std::make_unique<AStarOctile>(); }, 3);
+        executor.prepare(maze);
+        auto batch = executor.run(maze, queries);
+        assert(batch.results.size() == queries.size() && batch.latencies.size() == queries.size());
+        assert(batch.queriesPerSecond > 0);
+        assert(batch.latencyPercentile(0.5) <= batch.latencyPercentile(1.0));
+        for (size_t i = 0; i < queries.size(); ++i) {
+            auto expected = sequential.findPath(maze, queries[i].start, queries[i].goal);
+            assert(batch.results[i].path.empty() == expected.path.empty());
+            assert(octileCost(batch.results[i].path) == octileCost(expected.path));
+        }
+
+        // Workers search with preprocessing built once: tables are shared,
+        // the HPA* hierarchy is copied without being rebuilt
+        ALTAStar alt(4, 1), altWorker(4, 1);
+        alt.prepare(maze);
+        assert(altWorker.sharePreprocessing(alt) && &altWorker.getLandmarkTable() == &alt.getLandmarkTable());
+        assert(!altWorker.sharePreprocessing(sequential) && !sequential.sharePreprocessing(alt));
+        JPSOctile jps, jpsWorker;
+        JPSPlus jpsPlus, jpsPlusWorker;
+        assert(!jpsWorker.sharePreprocessing(jps) && jpsPlusWorker.sharePreprocessing(jpsPlus));
+        HPAStar hpa(16), hpaWorker(16);
+        hpa.prepare(maze);
+        assert(hpaWorker.sharePreprocessing(hpa) && hpaWorker.getEntranceCount() == hpa.getEntranceCount());
+        auto hpaResult = hpaWorker.findPath(maze, queries[1].start, queries[1].goal);
+        assert(hpaWorker.getLastRebuildCount() == 0);
+        assert(hpaResult.path == hpa.findPath(maze, queries[1].start, queries[1].goal).path);
+
+        BatchExecutor jpsExecutor([] { return std::make_unique<JPSPlus>(); }, 3);
+        jpsExecutor.prepare(maze);
+        auto jpsBatch = jpsExecutor.run(maze, queries);
+        for (size_t i = 0; i < queries.size(); ++i) {
+            auto expected = sequential.findPath(maze, queries[i].start, queries[i].goal);
+            assert(octileCost(jpsBatch.results[i].path) == octileCost(expected.path));
+        }
+
+        std::cout << "PASSED\n";
+    }
+
+    void testFlowFields() {
+        std::cout << "Testing flow fields... ";
+
+        Maze maze;
+        maze.generateRandom(100, 80, 0.25f);
+        const Maze::Point dock(50, 40);
+        maze.setCellType(dock.x, dock.y, Maze::CellType::PATH);
+        IntegerDijkstra<QuadHeap<int>, OctileCost> reference("reference");
+
+        // The first agent builds the field, the rest only walk it, and every
+        // walk is a cheapest route
+        FlowFieldPathfinder flow;
+        std::mt19937 rng(3);
+        bool built = false;
+        for (int agent = 0; agent < 40; ++agent) {
+            Maze::Point start(static_cast<int>(rng() % 100), static_cast<int>(rng() % 80));
+            auto result = flow.findPath(maze, start, dock);
+            auto expected = reference.findPath(maze, start, dock);
+            assert(result.path.empty() == expected.path.empty());
+            assert(octileCost(result.path) == octileCost(expected.path));
+            if (result.path.empty()) continue;
+            if (built) {
+                assert(flow.lastWasCacheHit() && result.nodesExplored == 0);
+            }
+            built = true;
+        }
+
+        // Agents stepped together end up where single walks do
+        std::shared_ptr<const FlowField> field = flow.getField(maze, dock);
+        std::vector<int> agents;
+        for (int x = 0; x < 100; x += 7) {
+            if (field->reaches(maze.index(x, 0))) agents.push_back(maze.index(x, 0));
+        }
+        std::vector<int> expected = agents;
+        for (int& agent : expected) agent = field->next(field->next(agent));
+        field->advance(agents);
+        field->advance(agents);
+        assert(agents == expected);
+
+        // Edits drop the cached fields; fields already handed out stay valid
+        // for the maze they were built from
+        maze.setCellType(dock.x + 1, dock.y, maze.isWalkable(dock.x + 1, dock.y) ? Maze::CellType::WALL : Maze::CellType::PATH);
+        auto rebuilt = flow.findPath(maze, Maze::Point(0, 0), dock);
+        assert(!flow.lastWasCacheHit());
+        assert(octileCost(rebuilt.path) == octileCost(reference.findPath(maze, Maze::Point(0, 0), dock).path));
+        assert(field->getWalkabilityStamp() != maze.getWalkabilityStamp());
+
+        std::cout << "PASSED\n";
+    }
+
+    void testBidirectionalSearch() {
+        std::cout << "Testing bidirectional search... ";
+
+        // Both meet on shortest paths: BFS length for the 4-way search,
+        // octile-optimal cost for A*, including endpoints that coincide
+        std::mt19937 rng(17);
+        IntegerDijkstra<QuadHeap<int>, OctileCost> reference("reference");
+        BidirectionalBFS bfs;
+        BidirectionalAStar astar;
+        for (int i = 0; i < 60; ++i) {
+            Maze maze;
+            const int width = 2 + static_cast<int>(rng() % 80);
+            const int height = 2 + static_cast<int>(rng() % 60);
+            maze.generateRandom(width, height, 0.05f * (i % 8));
+            Maze::Point start(static_cast<int>(rng() % width), static_cast<int>(rng() % height));
+            Maze::Point goal = i % 10 == 0 ? start : Maze::Point(static_cast<int>(rng() % width), static_cast<int>(rng() % height));
+
+            auto expected = BFS().findPath(maze, start, goal);
+            auto result = bfs.findPath(maze, start, goal);
+            assert(result.path.size() == expected.path.size());
+            for (size_t j = 1; j < result.path.size(); ++j) {
+                assert(std::abs(result.path[j].x - result.path[j - 1].x) +
+                       std::abs(result.path[j].y - result.path[j - 1].y) == 1);
+                assert(maze.isWalkable(result.path[j].x, result.path[j].y));
+            }
+
+            auto optimal = reference.findPath(maze, start, goal);
+            auto octile = astar.findPath(maze, start, goal);
+            assert(octile.path.empty() == optimal.path.empty());
+            assert(octileCost(octile.path) == octileCost(optimal.path));
+            if (!octile.path.empty()) {
+                assert(octile.path.front() == start && octile.path.back() == goal);
+            }
+        }
+
+        // On an open map the two fronts each cover about half the distance,
+        // so far fewer cells are expanded than by a one-sided BFS
+        Maze open;
+        open.resize(200, 200);
+        const Maze::Point west(50, 100), east(150, 100);
+        assert(bfs.findPath(open, west, east).nodesExplored * 3 <
+               BFS().findPath(open, west, east).nodesExplored * 2);
+        assert(octileCost(astar.findPath(open, west, east).path) ==
+               octileCost(reference.findPath(open, west, east).path));
+
+        std::cout << "PASSED\n";
+    }
+
+    void testLandmarks() {
+        std::cout << "Testing ALT landmarks... ";
+
+        // Octile-optimal on random maps, with few or many landmarks and
+        // tables rebuilt after edits
+        std::mt19937 rng(19);
+        IntegerDijkstra<QuadHeap<int>, OctileCost> reference("reference");
+        for (int i = 0; i < 30; ++i) {
+            Maze maze;
+            const int width = 2 + static_cast<int>(rng() % 60);
+            const int height = 2 + static_cast<int>(rng() % 60);
+            maze.generateRandom(width, height, 0.04f * (i % 10));
+            ALTAStar alt(1 + i % 8, 2);
+            for (int query = 0; query < 6; ++query) {
+                if (query == 3) maze.setCellType(static_cast<int>(rng() % width), static_cast<int>(rng() % height), Maze::CellType::WALL);
+                Maze::Point start(static_cast<int>(rng() % width), static_cast<int>(rng() % height));
+                Maze::Point goal(static_cast<int>(rng() % width), static_cast<int>(rng() % height));
+                auto result = alt.findPath(maze, start, goal);
+                auto expected = reference.findPath(maze, start, goal);
+                assert(result.path.empty() == expected.path.empty());
+                assert(octileCost(result.path) == octileCost(expected.path));
+            }
+        }
+
+        // Shelf blocks and a long wall with one door: straight-line bounds
+        // point into the wall, landmark bounds go round it
+        Maze warehouse;
+        warehouse.resize(100, 100);
+        for (int x = 4; x < 96; x += 5) {
+            for (int y = 4; y < 96; y += 20) warehouse.fillRect(Maze::Rect(x, y, 3, 16), Maze::CellType::WALL);
+        }
+        warehouse.fillRect(Maze::Rect(0, 50, 95, 1), Maze::CellType::WALL);
+        ALTAStar alt;
+        alt.prepare(warehouse);
+        assert(alt.getLandmarkTable().landmarkCount() == 16);
+        AStarOctile astar;
+        size_t altNodes = 0, astarNodes = 0;
+        for (int query = 0; query < 40; ++query) {
+            Maze::Point start(static_cast<int>(rng() % 100), static_cast<int>(rng() % 50));
+            Maze::Point goal(static_cast<int>(rng() % 100), 51 + static_cast<int>(rng() % 49));
+            auto result = alt.findPath(warehouse, start, goal);
+            assert(octileCost(result.path) == octileCost(reference.findPath(warehouse, start, goal).path));
+            altNodes += result.nodesExplored;
+            astarNodes += astar.findPath(warehouse, start, goal).nodesExplored;
+        }
+        assert(altNodes * 5 < astarNodes);
+
+        // A serpentine long enough to overflow 16-bit distances stores
+        // them scaled and still finds the cheapest path
+        Maze serpentine = makeSerpentine();
+        for (Maze::Point goal : {Maze::Point(119, 118), Maze::Point(3, 60)}) {
+            assert(octileCost(alt.findPath(serpentine, Maze::Point(0, 0), goal).path) ==
+                   octileCost(reference.findPath(serpentine, Maze::Point(0, 0), goal).path));
+        }
+
+        std::cout << "PASSED\n";
+    }
+
+    void testAnytimeSearch() {
+        std::cout << "Testing anytime search... ";
+
+        // Without a budget the improvements end at the optimum; on the way
+        // costs and bounds only fall, and each cost is within its bound
+        std::mt19937 rng(23);
+        IntegerDijkstra<QuadHeap<int>, OctileCost> reference("reference");
+        ARAStar ara(3.0, 0.5);
+        for (int i = 0; i < 30; ++i) {
+            Maze maze;
+            const int width = 10 + static_cast<int>(rng() % 80);
+            const int height = 10 + static_cast<int>(rng() % 80);
+            maze.generateRandom(width, height, 0.05f * (i % 7));
+            Maze::Point start(static_cast<int>(rng() % width), static_cast<int>(rng() % height));
+            Maze::Point goal(static_cast<int>(rng() % width), static_cast<int>(rng() % height));
+
+            auto result = ara.findPath(maze, start, goal);
+            const int optimal = octileCost(reference.findPath(maze, start, goal).path);
+            assert(octileCost(result.path) == optimal);
+            if (result.path.empty()) continue;
+
+            assert(result.suboptimalityBound == 1.0);
+            assert(!result.improvements.empty() && result.improvements.front().bound <= 3.0);
+            for (size_t j = 0; j < result.improvements.size(); ++j) {
+                const Pathfinder::Improvement& improvement = result.improvements[j];
+                assert(improvement.cost * 10 <= improvement.bound * optimal + 1e-6);
+                if (j > 0) {
+                    assert(improvement.cost <= result.improvements[j - 1].cost);
+                    assert(improvement.bound <= result.improvements[j - 1].bound);
+                    assert(improvement.elapsed >= result.improvements[j - 1].elapsed);
+                }
+            }
+            assert(std::abs(result.improvements.back().cost * 10 - optimal) < 1e-6);
+        }
+
+        // A budget too small for any improvement still returns the first,
+        // inflated path with its bound
+        Maze maze;
+        maze.generateRandom(300, 300, 0.3f);
+        maze.fillRect(Maze::Rect(1, 0, 298, 1), Maze::CellType::PATH);
+        maze.fillRect(Maze::Rect(299, 0, 1, 299), Maze::CellType::PATH);
+        ARAStar hurried(3.0, 0.5, 1e-6);
+        auto result = hurried.findPath(maze);
+        assert(result.improvements.size() == 1);
+        assert(!result.path.empty() && result.suboptimalityBound <= 3.0);
+        assert(octileCost(result.path) <= result.suboptimalityBound * octileCost(reference.findPath(maze).path) + 1e-6);
+
+        std::cout << "PASSED\n";
+    }
+
+    void testSearchLimits() {
+        std::cout << "Testing search limits... ";
+
+        // A serpentine: no search reaches the far end in a few expansions
+        Maze maze = makeSerpentine();
+        const Maze::Point start(0, 0), goal(119, 118);
+
+        std::vector<std::unique_ptr<Pathfinder>> algorithms;
+        algorithms.push_back(std::make_unique<BFS>());
+        algorithms.push_back(std::make_unique<AStarOctile>());
+        algorithms.push_back(std::make_unique<JPSOctile>());
+        algorithms.push_back(std::make_unique<JPSPlus>());
+        algorithms.push_back(std::make_unique<HPAStar>());
+        algorithms.push_back(std::make_unique<DStarLite>());
+        algorithms.push_back(std::make_unique<ParallelBFS>(2));
+        algorithms.push_back(std::make_unique<BitWavefront>());
+        algorithms.push_back(std::make_unique<FlowFieldPathfinder>());
+        algorithms.push_back(std::make_unique<BidirectionalBFS>());
+        algorithms.push_back(std::make_unique<BidirectionalAStar>());
+        algorithms.push_back(std::make_unique<ALTAStar>());
+        algorithms.push_back(std::make_unique<ARAStar>());
+
+        auto checkPartial = [&](const Pathfinder::PathfindingResult& result) {
+            if (result.path.empty()) return;
+            assert(result.path.front() == start && result.path.back() != goal);
+            for (size_t i = 1; i < result.path.size(); ++i) {
+                assert(std::abs(result.path[i].x - result.path[i - 1].x) <= 1);
+                assert(std::abs(result.path[i].y - result.path[i - 1].y) <= 1);
+                assert(maze.isWalkable(result.path[i].x, result.path[i].y));
+            }
+        };
+
+        auto token = std::make_shared<Pathfinder::CancellationToken>();
+        for (auto& algorithm : algorithms) {
+            algorithm->prepare(maze);
+
+            Pathfinder::SearchLimits budget;
+            budget.maxNodes = 20;
+            algorithm->setLimits(budget);
+            auto exhausted = algorithm->findPath(maze, start, goal);
+            assert(exhausted.status == Pathfinder::SearchStatus::EXHAUSTED);
+            assert(exhausted.nodesExplored <= budget.maxNodes + 8);
+            checkPartial(exhausted);
+
+            Pathfinder::SearchLimits deadline;
+            deadline.timeBudgetMs = 1e-6;
+            algorithm->setLimits(deadline);
+            auto late = algorithm->findPath(maze, start, goal);
+            assert(late.status == Pathfinder::SearchStatus::TIMED_OUT);
+            checkPartial(late);
+
+            Pathfinder::SearchLimits cancellable;
+            cancellable.cancellation = token;
+            algorithm->setLimits(cancellable);
+            token->cancel();
+            auto cancelled = algorithm->findPath(maze, start, goal);
+            assert(cancelled.status == Pathfinder::SearchStatus::CANCELLED);
+            checkPartial(cancelled);
+
+            // Once the token is reset the same limits let queries finish,
+            // with searches that keep state picking up where they stopped
+            token->reset();
+            auto found = algorithm->findPath(maze, start, goal);
+            assert(found.status == Pathfinder::SearchStatus::FOUND);
+            assert(found.path.front() == start && found.path.back() == goal);
+
+            algorithm->setLimits(Pathfinder::SearchLimits());
+            maze.setCellType(1, 0, Maze::CellType::WALL);
+            assert(algorithm->findPath(maze, start, goal).status == Pathfinder::SearchStatus::NO_PATH);
+            maze.setCellType(1, 0, Maze::CellType::PATH);
+        }
+
+        // A stopped search returns the route to the expanded cell nearest
+        // the goal, and only from its own query
+        Maze open;
+        open.resize(200, 200);
+        AStarOctile astar;
+        Pathfinder::SearchLimits budget;
+        budget.maxNodes = 50;
+        astar.setLimits(budget);
+        auto partial = astar.findPath(open, Maze::Point(0, 0), Maze::Point(199, 199));
+        assert(partial.status == Pathfinder::SearchStatus::EXHAUSTED);
+        assert(partial.path.front() == Maze::Point(0, 0) && partial.path.back().x >= 20 && partial.path.back().y >= 20);
+        auto back = astar.findPath(open, Maze::Point(199, 0), Maze::Point(0, 0));
+        assert(back.path.front() == Maze::Point(199, 0) && back.path.back().x <= 179);
+
+        std::cout << "PASSED\n";
+    }
+
+    void testSteppedSearch() {
+        std::cout << "Testing stepped search... ";
+
+        Maze maze;
+        maze.resize(60, 45);
+        maze.generateRandom(60, 45, 0.25f);
+        maze.fillRect(Maze::Rect(1, 0, 58, 1), Maze::CellType::PATH);
+        maze.fillRect(Maze::Rect(59, 0, 1, 44), Maze::CellType::PATH);
+
+        std::vector<std::unique_ptr<Pathfinder>> algorithms;
+        algorithms.push_back(std::make_unique<BFS>());
+        algorithms.push_back(std::make_unique<AStarOctile>());
+        algorithms.push_back(std::make_unique<JPSOctile>());
+        algorithms.push_back(std::make_unique<DStarLite>());
+        algorithms.push_back(std::make_unique<BidirectionalAStar>());
+        algorithms.push_back(std::make_unique<ARAStar>());
+
+        // Stepped a few expansions at a time, every algorithm ends where a
+        // headless query does, having reported each expansion once
+        for (size_t a = 0; a < algorithms.size(); ++a) {
+            Pathfinder& algorithm = *algorithms[a];
+            auto headless = algorithm.findPath(maze);
+
+            size_t steps = 0;
+            SteppedSearch search(algorithm, maze, maze.getStart(), maze.getGoal());
+            while (!search.finished()) {
+                steps += search.advance(7).size();
+                std::this_thread::yield();
+            }
+            steps += search.advance(0).size();
+
+            assert(search.result().status == headless.status);
+            assert(search.result().path == headless.path);
+            if (a < 2) assert(steps == headless.nodesExplored);
+            assert(!algorithm.getLimits().cancellation);
+        }
+
+        // A serpentine keeps the search busy well past the steps allowed
+        Maze serpentine = makeSerpentine();
+        const Maze::Point start(0, 0), goal(119, 118);
+        AStarOctile astar;
+
+        // Without steps allowed the search waits, and advance() never does
+        {
+            SteppedSearch search(astar, serpentine, start, goal);
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            assert(search.advance(0).empty() && !search.finished());
+
+            size_t steps = search.advance(5).size();
+            while (steps < 5) steps += search.advance(0).size();
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            assert(search.advance(0).empty() && !search.finished());
+
+            search.cancel();
+            while (!search.finished()) std::this_thread::yield();
+            assert(search.result().status == Pathfinder::SearchStatus::CANCELLED);
+            assert(search.result().path.front() == start);
+        }
+
+        // Dropping a parked search stops it and hands the limits back
+        Pathfinder::SearchLimits limits;
+        limits.maxNodes = 1000000;
+        astar.setLimits(limits);
+        {
+            SteppedSearch search(astar, serpentine, start, goal);
+            search.advance(100);
+        }
+        assert(astar.getLimits().maxNodes == limits.maxNodes && !astar.getLimits().cancellation);
+        assert(astar.findPath(serpentine, start, goal).status == Pathfinder::SearchStatus::FOUND);
+
+        // A token the caller had set still cancels the stepped search
+        auto owner = std::make_shared<Pathfinder::CancellationToken>();
+        limits.cancellation = owner;
+        astar.setLimits(limits);
+        {
+            SteppedSearch search(astar, serpentine, start, goal);
+            owner->cancel();
+            search.advance(1000000);
+            while (!search.finished()) search.advance(0);
+            assert(search.result().status == Pathfinder::SearchStatus::CANCELLED);
+        }
+        assert(astar.getLimits().cancellation == owner);
+
+        std::cout << "PASSED\n";
+    }
+
+    void testSearchTraces() {
+        std::cout << "Testing search traces... ";
+
+        Maze maze;
+        maze.resize(60, 60);
+        maze.generateRandom(60, 60, 0.25f);
+        maze.fillRect(Maze::Rect(1, 0, 58, 1), Maze::CellType::PATH);
+        maze.fillRect(Maze::Rect(59, 0, 1, 59), Maze::CellType::PATH);
+        const int goalIndex = maze.index(maze.getGoal().x, maze.getGoal().y);
+
+        std::vector<std::unique_ptr<Pathfinder>> algorithms;
+        algorithms.push_back(std::make_unique<BFS>());
+        algorithms.push_back(std::make_unique<AStarOctile>());
+        algorithms.push_back(std::make_unique<ALTAStar>());
+        algorithms.push_back(std::make_unique<JPSOctile>());
+        algorithms.push_back(std::make_unique<ARAStar>());
+        algorithms.push_back(std::make_unique<HPAStar>());
+        algorithms.push_back(std::make_unique<DStarLite>());
+        algorithms.push_back(std::make_unique<ParallelBFS>(2));
+        algorithms.push_back(std::make_unique<BitWavefront>());
+        algorithms.push_back(std::make_unique<FlowFieldPathfinder>());
+        algorithms.push_back(std::make_unique<BidirectionalBFS>());
+        algorithms.push_back(std::make_unique<BidirectionalAStar>());
+
+        // Tracing leaves the searches alone, and every algorithm reports its
+        // expansions; the first three also rebuild their path from the trace.
+        // Detached, the trace records nothing more.
+        SearchTrace trace(1 << 16);
+        for (size_t a = 0; a < algorithms.size(); ++a) {
+            Pathfinder& algorithm = *algorithms[a];
+            algorithm.setTrace(&trace);
+            auto traced = algorithm.findPath(maze);
+            algorithm.setTrace(nullptr);
+            const size_t recorded = trace.recorded();
+            auto plain = algorithm.findPath(maze);
+            assert(traced.path == plain.path && traced.status == Pathfinder::SearchStatus::FOUND);
+            assert(trace.recorded() == recorded);
+            assert(trace.dropped() == 0 && trace.getAlgorithm() == algorithm.getName());
+            assert(trace.getStart() == maze.getStart() && trace.getGoal() == maze.getGoal());
+
+            size_t expansions = 0;
+            for (size_t i = 0; i < trace.size(); ++i) expansions += trace[i].isExpansion();
+            assert(expansions > 0);
+            if (a < 3) {
+                assert(expansions == traced.nodesExplored);
+                TraceReplay replay(trace);
+                replay.seek(replay.length());
+                assert(replay.pathTo(goalIndex) == traced.path);
+            }
+        }
+
+        // Replays move both ways and end up where a straight run does
+        AStarOctile astar;
+        astar.setTrace(&trace);
+        auto result = astar.findPath(maze);
+        TraceReplay replay(trace);
+        const int width = maze.getWidth();
+        for (size_t position : {trace.size() / 2, size_t(3), trace.size(), size_t(0), trace.size() / 3}) {
+            replay.seek(position);
+            assert(replay.position() == position);
+
+            TraceReplay straight(trace);
+            straight.seek(position);
+            assert(replay.current() == straight.current());
+            for (int cell = 0; cell < width * maze.getHeight(); ++cell) {
+                assert(replay.expanded(cell) == straight.expanded(cell));
+                assert(replay.parent(cell) == straight.parent(cell));
+            }
+            if (replay.current() >= 0) {
+                auto path = replay.pathTo(replay.current());
+                assert(path.front() == maze.getStart() && path.back() == maze.pointAt(replay.current()));
+            }
+        }
+        replay.seek(trace.size() * 2);
+        assert(replay.atEnd() && replay.pathTo(goalIndex) == result.path);
+
+        // Saved traces load back event for event, wrapped ones included
+        SearchTrace small(100);
+        assert(small.capacity() == 128);
+        astar.setTrace(&small);
+        astar.findPath(maze);
+        astar.setTrace(nullptr);
+        assert(small.recorded() > small.capacity() && small.size() == small.capacity());
+        assert(small[small.size() - 1].isExpansion() && small[small.size() - 1].cell == goalIndex);
+
+        const std::string tracePath = "test_search.trace";
+        for (const SearchTrace* saved : {&trace, &small}) {
+            assert(saved->save(tracePath));
+            SearchTrace loaded(4);
+            assert(loaded.load(tracePath));
+            assert(loaded.recorded() == saved->recorded() && loaded.size() == saved->size());
+            assert(loaded.getAlgorithm() == saved->getAlgorithm() && loaded.getGoal() == saved->getGoal());
+            for (size_t i = 0; i < loaded.size(); ++i) {
+                assert(loaded[i].cell == (*saved)[i].cell && loaded[i].parent == (*saved)[i].parent);
+            }
+        }
+        std::remove(tracePath.c_str());
+
+        std::cout << "PASSED\n";
+    }
+
+    void testDirtyRendering() {
+        std::cout << "Testing dirty rendering... ";
+
+        // The maze lists the cells whose display changed, once each time
+        Maze maze;
+        maze.resize(600, 300);
+        std::vector<int> cells;
+        assert(maze.takeDisplayChanges(cells));
+        assert(!maze.takeDisplayChanges(cells) && cells.empty());
+
+        maze.setCellType(10, 10, Maze::CellType::WALL);
+        maze.setCellType(10, 10, Maze::CellType::WALL);
+        maze.setOverlay(300, 20, Maze::CellType::VISITED);
+        maze.setOverlay(300, 20, Maze::CellType::VISITED);
+        assert(!maze.takeDisplayChanges(cells));
+        assert(cells.size() == 2 && cells[0] == maze.index(10, 10) && cells[1] == maze.index(300, 20));
+
+        // Overlay cleared by a reset or by a terrain edit on top of it
+        maze.setOverlay(5, 5, Maze::CellType::PATH_FOUND);
+        maze.clearOverlay();
+        maze.setOverlay(6, 6, Maze::CellType::VISITED);
+        maze.setCellType(6, 6, Maze::CellType::PATH);
+        assert(!maze.takeDisplayChanges(cells));
+        std::sort(cells.begin(), cells.end());
+        cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+        assert(cells == std::vector<int>({maze.index(5, 5), maze.index(6, 6), maze.index(300, 20)}));
+
+        // Bulk edits and long runs of changes ask for a full redraw
+        maze.fillRect(Maze::Rect(0, 0, 2, 2), Maze::CellType::WALL);
+        assert(!maze.takeDisplayChanges(cells) && cells.size() == 4);
+        maze.clear();
+        assert(maze.takeDisplayChanges(cells) && cells.empty());
+        for (int y = 0; y < 80; ++y) {
+            for (int x = 0; x < 600; ++x) maze.setOverlay(x, y, Maze::CellType::VISITED);
+        }
+        assert(maze.takeDisplayChanges(cells) && cells.empty());
+
+        // The renderer re-uploads only the tiles holding changed cells
+        MazeRenderer renderer;
+        auto redraw = [&]() {
+            renderer.update(maze);
+            return renderer.prepare(maze, Maze::Rect(0, 0, maze.getWidth(), maze.getHeight()), 0);
+        };
+        assert(redraw() == 6 && renderer.getTileCount() == 6);
+        assert(redraw() == 0);
+        maze.setCellType(599, 299, Maze::CellType::WALL);
+        assert(redraw() == 1);
+        maze.setOverlay(0, 0, Maze::CellType::PATH_FOUND);
+        maze.setOverlay(1, 1, Maze::CellType::PATH_FOUND);
+        maze.setOverlay(256, 0, Maze::CellType::PATH_FOUND);
+        assert(redraw() == 2);
+        maze.resize(100, 100);
+        assert(redraw() == 1 && renderer.getTileCount() == 1);
+
+        assert(MazeRenderer::colorOf(Maze::CellType::WALL) == sf::Color::Black);
+        assert(MazeRenderer::colorOf(Maze::CellType::PATH) == sf::Color::White);
+
+        std::cout << "PASSED\n";
+    }
+
+    void testLevelOfDetail() {
+        std::cout << "Testing level-of-detail rendering... ";
+
+        // A texel covers at least one screen pixel
+        assert(MazeRenderer::levelFor(20.f) == 0);
+        assert(MazeRenderer::levelFor(1.f) == 0);
+        assert(MazeRenderer::levelFor(0.5f) == 1);
+        assert(MazeRenderer::levelFor(0.3f) == 2);
+        assert(MazeRenderer::levelFor(1.f / 8192) == 13);
+        assert(MazeRenderer::levelFor(0.f) == MazeRenderer::MAX_LEVEL);
+
+        Maze maze;
+        maze.resize(4096, 4096);
+        const Maze::Rect whole(0, 0, 4096, 4096);
+        MazeRenderer renderer;
+        renderer.update(maze);
+
+        // Only tiles under the view are built
+        assert(renderer.prepare(maze, Maze::Rect(300, 300, 10, 10), 0) == 1 && renderer.getTileCount() == 1);
+        assert(renderer.prepare(maze, Maze::Rect(250, 250, 10, 10), 0) == 3 && renderer.getTileCount() == 4);
+        assert(renderer.prepare(maze, Maze::Rect(-50, -50, 10, 10), 0) == 0);
+
+        // Zoomed out, the whole maze fits in a few summary tiles
+        assert(renderer.prepare(maze, whole, 4) == 1);
+        assert(renderer.prepare(maze, whole, 3) == 4);
+        assert(renderer.prepare(maze, whole, 1) == 64);
+        assert(renderer.prepare(maze, whole, MazeRenderer::MAX_LEVEL) == 1);
+
+        // Edits reach the summary tiles holding them, through the pyramid
+        maze.setCellType(4000, 10, Maze::CellType::WALL);
+        renderer.update(maze);
+        assert(renderer.prepare(maze, whole, 3) == 1);
+        assert(renderer.prepare(maze, whole, 3) == 0);
+        maze.fillRect(Maze::Rect(0, 0, 64, 64), Maze::CellType::WALL);
+        renderer.update(maze);
+        assert(renderer.prepare(maze, whole, 3) == 1);
+        maze.clear();
+        renderer.update(maze);
+        assert(renderer.prepare(maze, whole, 3) == 4);
+
+        // The cache keeps every tile in view and drops the oldest beyond its size
+        assert(renderer.prepare(maze, whole, 0) == 256 && renderer.getTileCount() == 256);
+        renderer.prepare(maze, Maze::Rect(0, 0, 1, 1), 0);
+        assert(renderer.getTileCount() == MazeRenderer::MAX_TILES);
+        assert(renderer.prepare(maze, Maze::Rect(0, 0, 1, 1), 0) == 0);
+
+        std::cout << "PASSED\n";
+    }
+
+    // Two cells share a component exactly when a flood fill joins them
+    void checkComponents(const Maze& maze) {
+        const int width = maze.getWidth();
+        const int height = maze.getHeight();
+        std::vector<int> flood(static_cast<size_t>(width) * height, -1);
+        std::vector<int> componentOfFlood;
+        for (int cell = 0; cell < width * height; ++cell) {
+            Maze::Point p = maze.pointAt(cell);
+            if (!maze.isWalkable(p.x, p.y)) {
+                assert(maze.getComponent(p.x, p.y) == Maze::NO_COMPONENT);
+                continue;
+            }
+            if (flood[cell] < 0) {
+                const int id = static_cast<int>(componentOfFlood.size());
+                componentOfFlood.push_back(maze.getComponent(p.x, p.y));
+                std::vector<int> stack(1, cell);
+                flood[cell] = id;
+                while (!stack.empty()) {
+                    Maze::Point q = maze.pointAt(stack.back());
+                    stack.pop_back();
+                    for (int d = 0; d < Maze::DIRECTION_COUNT; ++d) {
+                        int x = q.x + Maze::DIRECTION_DX[d];
+                        int y = q.y + Maze::DIRECTION_DY[d];
+                        if (maze.isWalkable(x, y) && flood[maze.index(x, y)] < 0) {
+                            flood[maze.index(x, y)] = id;
+                            stack.push_back(maze.index(x, y));
+                        }
+                    }
+                }
+            }
+            assert(maze.getComponent(p.x, p.y) == componentOfFlood[flood[cell]]);
+        }
+        std::sort(componentOfFlood.begin(), componentOfFlood.end());
+        assert(std::unique(componentOfFlood.begin(), componentOfFlood.end()) == componentOfFlood.end());
+    }
+
+    void checkNeighborMasks(const Maze& maze) {
+        for (int y = -1; y <= maze.getHeight(); ++y) {
+            for (int x = -1; x <= maze.getWidth(); ++x) {
+                assert(maze.isPassable(x, y) == maze.isWalkable(x, y));
+            }
+        }
+        for (int y = 0; y < maze.getHeight(); ++y) {
+            for (int x = 0; x < maze.getWidth(); ++x) {
+                for (int d = 0; d < Maze::DIRECTION_COUNT; ++d) {
+                    bool bit = (maze.getNeighborMask(maze.index(x, y)) >> d) & 1;
+                    assert(bit == maze.isWalkable(x + Maze::DIRECTION_DX[d], y + Maze::DIRECTION_DY[d]));
+                }
+            }
+        }
+    }
+
+    // Keys never drop below the last popped key, as in Dijkstra
+    template<typename OpenList>
+    void testMonotoneQueue() {
+        OpenList open;
+        open.reset(16);
+        open.push(0, 20);
+        assert(open.pop() == 0);
+        open.push(4, 34);
+        open.push(5, 30);
+        open.push(6, 24);
+        open.decreaseKey(4, 21);
+        assert(open.contains(5) && !open.contains(0));
+        assert(open.pop() == 4);
+        open.push(7, 22);
+        assert(open.pop() == 7);
+        assert(open.pop() == 6);
+        assert(open.pop() == 5);
+        assert(open.empty());
+    }
+
+    // Path cost in OctileCost units
+    int octileCost(const std::vector<Maze::Point>& path) {
+        int cost = 0;
+        for (size_t i = 1; i < path.size(); ++i) {
+            cost += OctileCost::step(path[i].x - path[i - 1].x, path[i].y - path[i - 1].y);
+        }
+        return cost;
+    }
+
+    // 120x120 walled rows open at alternate ends, so the only route from
+    // (0, 0) to (119, 118) sweeps the whole grid
+    Maze makeSerpentine() {
+        Maze maze;
+        maze.resize(120, 120);
+        for (int y = 1; y < 120; y += 2) {
+            maze.fillRect(Maze::Rect(y % 4 == 1 ? 0 : 1, y, 119, 1), Maze::CellType::WALL);
+        }
+        return maze;
+    }
+
+    // Euclidean length of a cell path
+    double pathCost(const std::vector<Maze::Point>& path) {
+        double cost = 0.0;
+        for (size_t i = 1; i < path.size(); ++i) {
+            cost += std::hypot(path[i].x - path[i - 1].x, path[i].y - path[i - 1].y);
+        }
+        return cost;
+    }
+
     template<typename Algorithm>
     void testAlgorithm(const Maze& maze, bool shouldFindPath) {
         Algorithm algorithm;